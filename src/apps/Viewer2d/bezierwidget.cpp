@@ -10,6 +10,8 @@
 namespace {
 constexpr double kHitRadius = 6.0;
 constexpr int kPointRadius = 5;
+// Quarter of a pixel: the flattened polyline is indistinguishable from the curve on screen.
+constexpr double kFlattenTolerance = 0.25;
 
 QPointF toPointF(const plane_geometry::Point2D<double>& point) {
     return {point.x, point.y};
@@ -57,6 +59,18 @@ void BezierWidget::setSampleCount(int count) {
     rebuildCurve();
 }
 
+bool BezierWidget::flattenEnabled() const {
+    return m_flatten;
+}
+
+void BezierWidget::setFlattenEnabled(bool enabled) {
+    if (m_flatten == enabled) {
+        return;
+    }
+    m_flatten = enabled;
+    rebuildCurve();
+}
+
 QVector<QPointF> BezierWidget::controlPoints() const {
     return m_controlPoints;
 }
@@ -189,7 +203,8 @@ void BezierWidget::rebuildCurve() {
     }
 
     const std::vector<plane_geometry::Point2D<double>> samples =
-        plane_geometry::sampleBezier(control, static_cast<std::size_t>(m_sampleCount));
+        m_flatten ? plane_geometry::flattenBezier(control, kFlattenTolerance)
+                  : plane_geometry::sampleBezier(control, static_cast<std::size_t>(m_sampleCount));
 
     m_curvePoints.clear();
     m_curvePoints.reserve(static_cast<int>(samples.size()));
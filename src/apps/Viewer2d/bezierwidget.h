@@ -22,6 +22,9 @@ public:
     int sampleCount() const;
     void setSampleCount(int count);
 
+    bool flattenEnabled() const;
+    void setFlattenEnabled(bool enabled);
+
     QVector<QPointF> controlPoints() const;
     QVector<QPointF> curvePoints() const;
 
@@ -46,6 +49,7 @@ private:
 
     int m_degree = 1;
     int m_sampleCount = 100;
+    bool m_flatten = false;
     QVector<QPointF> m_controlPoints;
     QVector<QPointF> m_curvePoints;
 
@@ -98,6 +98,14 @@ MainWindow::MainWindow(QWidget* parent)
     // Triangulation tab
     m_triangulationCanvas = ui->triangulationCanvas;
     if (m_triangulationCanvas) {
+        connect(m_triangulationCanvas, &TriangulationWidget::pointAdded,
+                this, &MainWindow::onTriangulationPointAdded);
+        connect(m_triangulationCanvas, &TriangulationWidget::pointRemoved,
+                this, &MainWindow::onTriangulationPointRemoved);
+        connect(m_triangulationCanvas, &TriangulationWidget::pointMoved,
+                this, &MainWindow::onTriangulationPointMoved);
+        connect(m_triangulationCanvas, &TriangulationWidget::pointsCleared,
+                this, &MainWindow::onTriangulationPointsCleared);
         connect(m_triangulationCanvas, &TriangulationWidget::pointsChanged,
                 this, &MainWindow::onTriangulationPointsChanged);
     }
@@ -200,6 +208,11 @@ MainWindow::MainWindow(QWidget* parent)
         connect(ui->bezierSamplesSpin, QOverload<int>::of(&QSpinBox::valueChanged),
                 this, &MainWindow::onBezierSamplesChanged);
     }
+    if (ui->bezierFlattenCheckBox) {
+        ui->bezierFlattenCheckBox->setChecked(m_bezierCanvas && m_bezierCanvas->flattenEnabled());
+        connect(ui->bezierFlattenCheckBox, &QCheckBox::toggled,
+                this, &MainWindow::onBezierFlattenToggled);
+    }
     if (ui->bezierDragCheckBox) {
         ui->bezierDragCheckBox->setChecked(true);
         connect(ui->bezierDragCheckBox, &QCheckBox::toggled,
@@ -703,6 +716,60 @@ void MainWindow::onTriangulationPointsChanged(const QVector<QPointF>& /*points*/
     }
 }
 
+void MainWindow::onTriangulationPointAdded(int /*index*/, const QPointF& position) {
+    m_delaunayVertices.push_back(m_delaunay.insert(PlanePointD{position.x(), position.y()}));
+}
+
+void MainWindow::onTriangulationPointRemoved(int index) {
+    if (index < 0 || index >= static_cast<int>(m_delaunayVertices.size())) {
+        return;
+    }
+    const std::uint32_t vertex = m_delaunayVertices[static_cast<std::size_t>(index)];
+    m_delaunayVertices.erase(m_delaunayVertices.begin() + index);
+    if (vertex != plane_geometry::DynamicDelaunayTriangulation<PlaneScalar>::InvalidVertex) {
+        m_delaunay.remove(vertex);
+        insertPendingTriangulationPoints();
+    }
+}
+
+void MainWindow::onTriangulationPointMoved(int index, const QPointF& position) {
+    if (index < 0 || index >= static_cast<int>(m_delaunayVertices.size())) {
+        return;
+    }
+    const std::uint32_t vertex = m_delaunayVertices[static_cast<std::size_t>(index)];
+    if (vertex == plane_geometry::DynamicDelaunayTriangulation<PlaneScalar>::InvalidVertex) {
+        insertPendingTriangulationPoints();
+        return;
+    }
+    if (!m_delaunay.move(vertex, PlanePointD{position.x(), position.y()})) {
+        // Dropped onto another point: take it out until it is dragged somewhere free.
+        m_delaunay.remove(vertex);
+        m_delaunayVertices[static_cast<std::size_t>(index)] =
+            plane_geometry::DynamicDelaunayTriangulation<PlaneScalar>::InvalidVertex;
+    }
+    // Moving a point away may free the spot of one taken out earlier.
+    insertPendingTriangulationPoints();
+}
+
+void MainWindow::onTriangulationPointsCleared() {
+    m_delaunay.clear();
+    m_delaunayVertices.clear();
+}
+
+void MainWindow::insertPendingTriangulationPoints() {
+    if (!m_triangulationCanvas) {
+        return;
+    }
+    const QVector<QPointF> points = m_triangulationCanvas->points();
+    for (std::size_t i = 0; i < m_delaunayVertices.size() && i < static_cast<std::size_t>(points.size()); ++i) {
+        if (m_delaunayVertices[i] != plane_geometry::DynamicDelaunayTriangulation<PlaneScalar>::InvalidVertex) {
+            continue;
+        }
+        const QPointF& point = points[static_cast<int>(i)];
+        m_delaunayVertices[i] = m_delaunay.insert(PlanePointD{point.x(), point.y()});
+    }
+}
+
 void MainWindow::onTriangulationComputeClicked() {
     computeDelaunayTriangulation();
 }
@@ -764,17 +831,21 @@ void MainWindow::computeDelaunayTriangulation() {
         return;
     }
 
-    const auto geometryPoints = toGeometryPoints(points);
-    const std::vector<plane_geometry::Triangle2D<double>> triangulation =
-        plane_geometry::delaunayTriangulation(geometryPoints);
+    const plane_geometry::TriangleMesh<PlaneScalar> mesh = m_delaunay.mesh();
+
+    QVector<QPointF> vertices;
+    vertices.reserve(static_cast<int>(mesh.vertices.size()));
+    for (const auto& vertex : mesh.vertices) {
+        vertices.append(QPointF(vertex.x, vertex.y));
+    }
 
     QVector<QPolygonF> triangles;
-    triangles.reserve(static_cast<int>(triangulation.size()));
-    for (const auto& triangle : triangulation) {
+    triangles.reserve(static_cast<int>(mesh.triangles.size()));
+    for (const auto& triangle : mesh.triangles) {
         QPolygonF polygon;
-        polygon << QPointF(triangle.a.x, triangle.a.y)
-                << QPointF(triangle.b.x, triangle.b.y)
-                << QPointF(triangle.c.x, triangle.c.y);
+        polygon << vertices[static_cast<int>(triangle[0])]
+                << vertices[static_cast<int>(triangle[1])]
+                << vertices[static_cast<int>(triangle[2])];
         triangles.append(polygon);
     }
 
@@ -1007,6 +1078,9 @@ void MainWindow::recomputeBooleanOperation() {
     case BooleanOperation::Difference:
         booleanResult = plane_geometry::differenceConvexPolygons(firstGeometry, secondGeometry);
         break;
+    case BooleanOperation::SymmetricDifference:
+        booleanResult = plane_geometry::xorPolygons(firstGeometry, secondGeometry);
+        break;
     }
 
     const auto toQPolygon = [](const plane_geometry::Polygon<double>& polygon) {
@@ -1040,6 +1114,9 @@ void MainWindow::recomputeBooleanOperation() {
                 statusHints << tr("Difference is empty.");
             }
             break;
+        case BooleanOperation::SymmetricDifference:
+            statusHints << tr("Polygons coincide; symmetric difference is empty.");
+            break;
         }
     } else {
         m_booleanOuters.reserve(booleanResult.outers.size());
@@ -1079,6 +1156,12 @@ void MainWindow::recomputeBooleanOperation() {
             } else if (firstContainsSecond && !booleanResult.holes.empty()) {
                 statusHints << tr("Second polygon lies inside the first; interior hole created.");
             }
+        } else if (operation == BooleanOperation::SymmetricDifference) {
+            if (polygonsDisjoint) {
+                statusHints << tr("Polygons do not overlap; symmetric difference shows both polygons.");
+            } else if ((firstContainsSecond || secondContainsFirst) && !booleanResult.holes.empty()) {
+                statusHints << tr("One polygon lies inside the other; the inner one becomes a hole.");
+            }
         }
     }
 
@@ -1093,6 +1176,8 @@ MainWindow::BooleanOperation MainWindow::currentBooleanOperation() const {
         return BooleanOperation::Union;
     case 2:
         return BooleanOperation::Difference;
+    case 3:
+        return BooleanOperation::SymmetricDifference;
     default:
         return BooleanOperation::Intersection;
     }
@@ -1250,6 +1335,16 @@ void MainWindow::onBezierSamplesChanged(int value) {
     }
 }
 
+void MainWindow::onBezierFlattenToggled(bool checked) {
+    if (m_bezierCanvas) {
+        m_bezierCanvas->setFlattenEnabled(checked);
+        if (ui->bezierSamplesSpin) {
+            ui->bezierSamplesSpin->setEnabled(!checked);
+        }
+        updateBezierInfo();
+    }
+}
+
 void MainWindow::onBezierDragToggled(bool checked) {
     if (m_bezierCanvas) {
         m_bezierCanvas->setDraggingEnabled(checked);
@@ -1274,7 +1369,11 @@ void MainWindow::updateBezierInfo() {
         const int controlCount = m_bezierCanvas->controlPoints().size();
         lines << tr("Degree: %1").arg(degree);
         lines << tr("Control points: %1 / %2").arg(controlCount).arg(required);
-        lines << tr("Sample count: %1").arg(m_bezierCanvas->sampleCount());
+        if (m_bezierCanvas->flattenEnabled()) {
+            lines << tr("Adaptive flattening within a quarter pixel");
+        } else {
+            lines << tr("Sample count: %1").arg(m_bezierCanvas->sampleCount());
+        }
         if (controlCount < required) {
             lines << QString();
             lines << tr("Add %1 more control point(s).").arg(required - controlCount);
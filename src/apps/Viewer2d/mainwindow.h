@@ -53,6 +53,10 @@ private slots:
     void onClearHullClicked();
 
     void onTriangulationPointsChanged(const QVector<QPointF>& points);
+    void onTriangulationPointAdded(int index, const QPointF& position);
+    void onTriangulationPointRemoved(int index);
+    void onTriangulationPointMoved(int index, const QPointF& position);
+    void onTriangulationPointsCleared();
     void onTriangulationComputeClicked();
     void onTriangulationLiveToggled(bool checked);
     void onTriangulationDragToggled(bool checked);
@@ -81,6 +85,7 @@ private slots:
     void onBezierCurveUpdated(const QVector<QPointF>& curve);
     void onBezierDegreeChanged(int index);
     void onBezierSamplesChanged(int value);
+    void onBezierFlattenToggled(bool checked);
     void onBezierDragToggled(bool checked);
     void onBezierClearClicked();
 
@@ -100,11 +105,13 @@ private:
 
     void updateTriangulationSummary();
     void computeDelaunayTriangulation();
+    void insertPendingTriangulationPoints();
 
     enum class BooleanOperation {
         Intersection,
         Union,
-        Difference
+        Difference,
+        SymmetricDifference
     };
     void updateBooleanSummary();
     void recomputeBooleanOperation();
@@ -140,6 +147,9 @@ private:
 
     TriangulationWidget* m_triangulationCanvas = nullptr;
     QVector<QPolygonF> m_triangulationTriangles;
+    plane_geometry::DynamicDelaunayTriangulation<PlaneScalar> m_delaunay;
+    // Vertex id per canvas point; InvalidVertex while the point coincides with another one.
+    std::vector<std::uint32_t> m_delaunayVertices;
     bool m_triangulationLive = false;
     QString m_triangulationSummary;
 
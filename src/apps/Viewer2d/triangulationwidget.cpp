@@ -32,6 +32,7 @@ void TriangulationWidget::clearPoints() {
     m_points.clear();
     clearTriangles();
     update();
+    emit pointsCleared();
     emit pointsChanged(m_points);
 }
 
@@ -63,6 +64,7 @@ void TriangulationWidget::mousePressEvent(QMouseEvent* event) {
             m_points.removeAt(index);
             clearTriangles();
             update();
+            emit pointRemoved(index);
             emit pointsChanged(m_points);
         }
         return;
@@ -85,6 +87,7 @@ void TriangulationWidget::mousePressEvent(QMouseEvent* event) {
     m_points.append(pos);
     clearTriangles();
     update();
+    emit pointAdded(m_points.size() - 1, pos);
     emit pointsChanged(m_points);
 }
 
@@ -153,6 +156,7 @@ void TriangulationWidget::updatePoint(int index, const QPointF& position) {
     m_points[index] = position;
     clearTriangles();
     update();
+    emit pointMoved(index, position);
     emit pointsChanged(m_points);
 }
 
@@ -23,6 +23,10 @@ public:
 
 signals:
     void pointsChanged(const QVector<QPointF>& points);
+    void pointAdded(int index, const QPointF& position);
+    void pointRemoved(int index);
+    void pointMoved(int index, const QPointF& position);
+    void pointsCleared();
 
 protected:
     void mousePressEvent(QMouseEvent* event) override;
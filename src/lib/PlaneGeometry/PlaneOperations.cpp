@@ -4,13 +4,28 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
 #include <limits>
 #include <map>
+#include <memory>
 #include <random>
+#include <set>
 #include <stdexcept>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define PLANE_GEOMETRY_HAS_SSE2 1
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PLANE_GEOMETRY_HAS_AVX2 1
+#endif
+#endif
+
 namespace plane_geometry {
 namespace detail {
 
@@ -97,6 +112,717 @@ inline Scalar orientationDet(const Point2D<Scalar>& a,
     return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
 }
 
+template <typename Scalar>
+inline int signOf(const Scalar& value) {
+    if (value > Scalar{}) {
+        return 1;
+    }
+    if (value < Scalar{}) {
+        return -1;
+    }
+    return 0;
+}
+
+template <typename Scalar>
+inline double toDouble(const Scalar& value) {
+    return static_cast<double>(value);
+}
+
+// static_cast<double> on cpp_dec_float goes through a string round trip, which would cost more
+// than the predicates themselves. Assemble the value from the leading limbs instead; the result
+// is within a few ulps of the correctly rounded conversion.
+inline double toDouble(const ExactScalar& value) {
+    const auto& backend = value.backend();
+    if (!(backend.isfinite)()) {
+        return backend.isneg() ? -std::numeric_limits<double>::infinity()
+                               : std::numeric_limits<double>::infinity();
+    }
+    constexpr double PowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                      1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                      1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    double mantissa = 0.0;
+    ExactScalar::backend_type::exponent_type exponent = 0;
+    backend.extract_parts(mantissa, exponent);
+    if (exponent >= 0 && exponent <= 22) {
+        return mantissa * PowersOfTen[exponent];
+    }
+    if (exponent < 0 && exponent >= -22) {
+        return mantissa / PowersOfTen[-exponent];
+    }
+    return mantissa * std::pow(10.0, static_cast<double>(exponent));
+}
+
+template <typename Scalar>
+inline ExactScalar toExact(const Scalar& value) {
+    return ExactScalar(value);
+}
+
+// Unit roundoff of double (2^-53).
+constexpr double DoubleRoundoff = std::numeric_limits<double>::epsilon() * 0.5;
+
+// Adaptive-precision orient2d / incircle for double input (after Shewchuk, "Adaptive Precision
+// Floating-Point Arithmetic and Fast Robust Geometric Predicates"). Each predicate runs through
+// stages A..D: a plain double evaluation, an exact expansion of the rounded differences, a
+// first-order correction by the difference tails and finally the fully exact expansion. Every
+// stage stops as soon as its error bound certifies the sign, so the common case costs a handful
+// of flops and degenerate input still gets the exact answer.
+//
+// Expansions are stored as arrays of non-overlapping doubles in increasing magnitude; the sign of
+// an expansion is the sign of its last component.
+
+constexpr double ResultErrorBound = (3.0 + 8.0 * DoubleRoundoff) * DoubleRoundoff;
+constexpr double OrientationErrorBoundA = (3.0 + 16.0 * DoubleRoundoff) * DoubleRoundoff;
+constexpr double OrientationErrorBoundB = (2.0 + 12.0 * DoubleRoundoff) * DoubleRoundoff;
+constexpr double OrientationErrorBoundC = (9.0 + 64.0 * DoubleRoundoff) * DoubleRoundoff * DoubleRoundoff;
+constexpr double IncircleErrorBoundA = (10.0 + 96.0 * DoubleRoundoff) * DoubleRoundoff;
+constexpr double IncircleErrorBoundB = (4.0 + 48.0 * DoubleRoundoff) * DoubleRoundoff;
+constexpr double IncircleErrorBoundC = (44.0 + 576.0 * DoubleRoundoff) * DoubleRoundoff * DoubleRoundoff;
+
+// 2^ceil(53 / 2) + 1, used to split a double into two non-overlapping halves.
+constexpr double ExpansionSplitter = 134217729.0;
+
+inline void fastTwoSum(double a, double b, double& x, double& y) {
+    x = a + b;
+    const double bVirtual = x - a;
+    y = b - bVirtual;
+}
+
+inline void twoSum(double a, double b, double& x, double& y) {
+    x = a + b;
+    const double bVirtual = x - a;
+    const double aVirtual = x - bVirtual;
+    const double bRound = b - bVirtual;
+    const double aRound = a - aVirtual;
+    y = aRound + bRound;
+}
+
+inline void twoDiffTail(double a, double b, double x, double& y) {
+    const double bVirtual = a - x;
+    const double aVirtual = x + bVirtual;
+    const double bRound = bVirtual - b;
+    const double aRound = a - aVirtual;
+    y = aRound + bRound;
+}
+
+inline void twoDiff(double a, double b, double& x, double& y) {
+    x = a - b;
+    twoDiffTail(a, b, x, y);
+}
+
+// With hardware FMA the compiler may contract the splitting arithmetic below, so the product
+// error is taken from fma directly; otherwise Dekker's split is exact.
+inline void splitDouble(double a, double& high, double& low) {
+    const double c = ExpansionSplitter * a;
+    const double big = c - a;
+    high = c - big;
+    low = a - high;
+}
+
+inline void twoProduct(double a, double b, double& x, double& y) {
+    x = a * b;
+#ifdef FP_FAST_FMA
+    y = std::fma(a, b, -x);
+#else
+    double aHigh = 0.0;
+    double aLow = 0.0;
+    double bHigh = 0.0;
+    double bLow = 0.0;
+    splitDouble(a, aHigh, aLow);
+    splitDouble(b, bHigh, bLow);
+    const double err1 = x - aHigh * bHigh;
+    const double err2 = err1 - aLow * bHigh;
+    const double err3 = err2 - aHigh * bLow;
+    y = aLow * bLow - err3;
+#endif
+}
+
+inline void twoOneDiff(double a1, double a0, double b, double& x2, double& x1, double& x0) {
+    double i = 0.0;
+    twoDiff(a0, b, i, x0);
+    twoSum(a1, i, x2, x1);
+}
+
+// (a1 + a0) - (b1 + b0) as a four-component expansion x[0..3].
+inline void twoTwoDiff(double a1, double a0, double b1, double b0, double* x) {
+    double j = 0.0;
+    double zero = 0.0;
+    twoOneDiff(a1, a0, b0, j, zero, x[0]);
+    twoOneDiff(j, zero, b1, x[3], x[2], x[1]);
+}
+
+inline int fastExpansionSumZeroElim(int eLength, const double* e, int fLength, const double* f, double* h) {
+    int eIndex = 0;
+    int fIndex = 0;
+    double eNow = e[0];
+    double fNow = f[0];
+    const auto nextE = [&]() { ++eIndex; eNow = eIndex < eLength ? e[eIndex] : 0.0; };
+    const auto nextF = [&]() { ++fIndex; fNow = fIndex < fLength ? f[fIndex] : 0.0; };
+
+    double q = 0.0;
+    if ((fNow > eNow) == (fNow > -eNow)) {
+        q = eNow;
+        nextE();
+    } else {
+        q = fNow;
+        nextF();
+    }
+    int hIndex = 0;
+    double qNew = 0.0;
+    double hh = 0.0;
+    if (eIndex < eLength && fIndex < fLength) {
+        if ((fNow > eNow) == (fNow > -eNow)) {
+            fastTwoSum(eNow, q, qNew, hh);
+            nextE();
+        } else {
+            fastTwoSum(fNow, q, qNew, hh);
+            nextF();
+        }
+        q = qNew;
+        if (hh != 0.0) {
+            h[hIndex++] = hh;
+        }
+        while (eIndex < eLength && fIndex < fLength) {
+            if ((fNow > eNow) == (fNow > -eNow)) {
+                twoSum(q, eNow, qNew, hh);
+                nextE();
+            } else {
+                twoSum(q, fNow, qNew, hh);
+                nextF();
+            }
+            q = qNew;
+            if (hh != 0.0) {
+                h[hIndex++] = hh;
+            }
+        }
+    }
+    while (eIndex < eLength) {
+        twoSum(q, eNow, qNew, hh);
+        nextE();
+        q = qNew;
+        if (hh != 0.0) {
+            h[hIndex++] = hh;
+        }
+    }
+    while (fIndex < fLength) {
+        twoSum(q, fNow, qNew, hh);
+        nextF();
+        q = qNew;
+        if (hh != 0.0) {
+            h[hIndex++] = hh;
+        }
+    }
+    if (q != 0.0 || hIndex == 0) {
+        h[hIndex++] = q;
+    }
+    return hIndex;
+}
+
+inline int scaleExpansionZeroElim(int eLength, const double* e, double b, double* h) {
+    double q = 0.0;
+    double hh = 0.0;
+    twoProduct(e[0], b, q, hh);
+    int hIndex = 0;
+    if (hh != 0.0) {
+        h[hIndex++] = hh;
+    }
+    for (int eIndex = 1; eIndex < eLength; ++eIndex) {
+        double product1 = 0.0;
+        double product0 = 0.0;
+        double sum = 0.0;
+        twoProduct(e[eIndex], b, product1, product0);
+        twoSum(q, product0, sum, hh);
+        if (hh != 0.0) {
+            h[hIndex++] = hh;
+        }
+        fastTwoSum(product1, sum, q, hh);
+        if (hh != 0.0) {
+            h[hIndex++] = hh;
+        }
+    }
+    if (q != 0.0 || hIndex == 0) {
+        h[hIndex++] = q;
+    }
+    return hIndex;
+}
+
+inline double estimateExpansion(int length, const double* e) {
+    double sum = e[0];
+    for (int i = 1; i < length; ++i) {
+        sum += e[i];
+    }
+    return sum;
+}
+
+using Expansion = std::vector<double>;
+
+inline Expansion expansionSum(const Expansion& e, const Expansion& f) {
+    Expansion h(e.size() + f.size());
+    h.resize(static_cast<std::size_t>(fastExpansionSumZeroElim(static_cast<int>(e.size()), e.data(),
+                                                               static_cast<int>(f.size()), f.data(), h.data())));
+    return h;
+}
+
+inline Expansion expansionProduct(const Expansion& e, const Expansion& f) {
+    Expansion result{0.0};
+    Expansion scaled(2 * e.size());
+    for (const double component : f) {
+        scaled.resize(2 * e.size());
+        scaled.resize(static_cast<std::size_t>(
+            scaleExpansionZeroElim(static_cast<int>(e.size()), e.data(), component, scaled.data())));
+        result = expansionSum(result, scaled);
+    }
+    return result;
+}
+
+inline Expansion expansionNegate(Expansion e) {
+    for (double& component : e) {
+        component = -component;
+    }
+    return e;
+}
+
+// Exact a - b as a (tail, head) expansion.
+inline Expansion exactDifference(double a, double b) {
+    double head = 0.0;
+    double tail = 0.0;
+    twoDiff(a, b, head, tail);
+    if (tail == 0.0) {
+        return {head};
+    }
+    return {tail, head};
+}
+
+inline double orient2dAdaptive(double ax, double ay, double bx, double by, double cx, double cy,
+                               double detSum) {
+    const double acx = ax - cx;
+    const double bcx = bx - cx;
+    const double acy = ay - cy;
+    const double bcy = by - cy;
+
+    // Stage B: exact determinant of the rounded differences.
+    double detLeft = 0.0;
+    double detLeftTail = 0.0;
+    double detRight = 0.0;
+    double detRightTail = 0.0;
+    twoProduct(acx, bcy, detLeft, detLeftTail);
+    twoProduct(acy, bcx, detRight, detRightTail);
+    double b[4];
+    twoTwoDiff(detLeft, detLeftTail, detRight, detRightTail, b);
+
+    double det = estimateExpansion(4, b);
+    double errorBound = OrientationErrorBoundB * detSum;
+    if (det >= errorBound || -det >= errorBound) {
+        return det;
+    }
+
+    double acxTail = 0.0;
+    double bcxTail = 0.0;
+    double acyTail = 0.0;
+    double bcyTail = 0.0;
+    twoDiffTail(ax, cx, acx, acxTail);
+    twoDiffTail(bx, cx, bcx, bcxTail);
+    twoDiffTail(ay, cy, acy, acyTail);
+    twoDiffTail(by, cy, bcy, bcyTail);
+    if (acxTail == 0.0 && acyTail == 0.0 && bcxTail == 0.0 && bcyTail == 0.0) {
+        return det;
+    }
+
+    // Stage C: first-order correction by the tails of the differences.
+    errorBound = OrientationErrorBoundC * detSum + ResultErrorBound * std::fabs(det);
+    det += (acx * bcyTail + bcy * acxTail) - (acy * bcxTail + bcx * acyTail);
+    if (det >= errorBound || -det >= errorBound) {
+        return det;
+    }
+
+    // Stage D: exact sum of all remaining terms.
+    double s1 = 0.0;
+    double s0 = 0.0;
+    double t1 = 0.0;
+    double t0 = 0.0;
+    double u[4];
+    double c1[8];
+    double c2[12];
+    double d[16];
+
+    twoProduct(acxTail, bcy, s1, s0);
+    twoProduct(acyTail, bcx, t1, t0);
+    twoTwoDiff(s1, s0, t1, t0, u);
+    const int c1Length = fastExpansionSumZeroElim(4, b, 4, u, c1);
+
+    twoProduct(acx, bcyTail, s1, s0);
+    twoProduct(acy, bcxTail, t1, t0);
+    twoTwoDiff(s1, s0, t1, t0, u);
+    const int c2Length = fastExpansionSumZeroElim(c1Length, c1, 4, u, c2);
+
+    twoProduct(acxTail, bcyTail, s1, s0);
+    twoProduct(acyTail, bcxTail, t1, t0);
+    twoTwoDiff(s1, s0, t1, t0, u);
+    const int dLength = fastExpansionSumZeroElim(c2Length, c2, 4, u, d);
+
+    return d[dLength - 1];
+}
+
+// Positive when a, b, c are in counter-clockwise order; same sign as orientationDet(a, b, c).
+inline double orient2dRobust(double ax, double ay, double bx, double by, double cx, double cy) {
+    const double detLeft = (ax - cx) * (by - cy);
+    const double detRight = (ay - cy) * (bx - cx);
+    const double det = detLeft - detRight;
+
+    double detSum = 0.0;
+    if (detLeft > 0.0) {
+        if (detRight <= 0.0) {
+            return det;
+        }
+        detSum = detLeft + detRight;
+    } else if (detLeft < 0.0) {
+        if (detRight >= 0.0) {
+            return det;
+        }
+        detSum = -detLeft - detRight;
+    } else {
+        return det;
+    }
+
+    const double errorBound = OrientationErrorBoundA * detSum;
+    if (det >= errorBound || -det >= errorBound) {
+        return det;
+    }
+    return orient2dAdaptive(ax, ay, bx, by, cx, cy, detSum);
+}
+
+// Scales the 4-component expansion bc by k twice (k^2 * bc) for both coordinates of one lifted term.
+inline int liftedTerm(const double* bc, double kx, double ky, double* out) {
+    double kxbc[8];
+    double kxxbc[16];
+    double kybc[8];
+    double kyybc[16];
+    const int kxbcLength = scaleExpansionZeroElim(4, bc, kx, kxbc);
+    const int kxxbcLength = scaleExpansionZeroElim(kxbcLength, kxbc, kx, kxxbc);
+    const int kybcLength = scaleExpansionZeroElim(4, bc, ky, kybc);
+    const int kyybcLength = scaleExpansionZeroElim(kybcLength, kybc, ky, kyybc);
+    return fastExpansionSumZeroElim(kxxbcLength, kxxbc, kyybcLength, kyybc, out);
+}
+
+inline double incircleExact(double ax, double ay, double bx, double by,
+                            double cx, double cy, double dx, double dy) {
+    const Expansion adx = exactDifference(ax, dx);
+    const Expansion ady = exactDifference(ay, dy);
+    const Expansion bdx = exactDifference(bx, dx);
+    const Expansion bdy = exactDifference(by, dy);
+    const Expansion cdx = exactDifference(cx, dx);
+    const Expansion cdy = exactDifference(cy, dy);
+
+    const auto lift = [](const Expansion& x, const Expansion& y) {
+        return expansionSum(expansionProduct(x, x), expansionProduct(y, y));
+    };
+    const auto crossTerm = [](const Expansion& x1, const Expansion& y2,
+                              const Expansion& x2, const Expansion& y1) {
+        return expansionSum(expansionProduct(x1, y2), expansionNegate(expansionProduct(x2, y1)));
+    };
+
+    const Expansion aTerm = expansionProduct(lift(adx, ady), crossTerm(bdx, cdy, cdx, bdy));
+    const Expansion bTerm = expansionProduct(lift(bdx, bdy), crossTerm(cdx, ady, adx, cdy));
+    const Expansion cTerm = expansionProduct(lift(cdx, cdy), crossTerm(adx, bdy, bdx, ady));
+    const Expansion det = expansionSum(expansionSum(aTerm, bTerm), cTerm);
+    return det.back();
+}
+
+inline double incircleAdaptive(double ax, double ay, double bx, double by,
+                               double cx, double cy, double dx, double dy,
+                               double permanent) {
+    const double adx = ax - dx;
+    const double bdx = bx - dx;
+    const double cdx = cx - dx;
+    const double ady = ay - dy;
+    const double bdy = by - dy;
+    const double cdy = cy - dy;
+
+    // Stage B: exact determinant of the rounded differences.
+    double p1 = 0.0;
+    double p0 = 0.0;
+    double q1 = 0.0;
+    double q0 = 0.0;
+    double bc[4];
+    double ca[4];
+    double ab[4];
+    twoProduct(bdx, cdy, p1, p0);
+    twoProduct(cdx, bdy, q1, q0);
+    twoTwoDiff(p1, p0, q1, q0, bc);
+    twoProduct(cdx, ady, p1, p0);
+    twoProduct(adx, cdy, q1, q0);
+    twoTwoDiff(p1, p0, q1, q0, ca);
+    twoProduct(adx, bdy, p1, p0);
+    twoProduct(bdx, ady, q1, q0);
+    twoTwoDiff(p1, p0, q1, q0, ab);
+
+    double aDet[32];
+    double bDet[32];
+    double cDet[32];
+    double abDet[64];
+    double fin[96];
+    const int aLength = liftedTerm(bc, adx, ady, aDet);
+    const int bLength = liftedTerm(ca, bdx, bdy, bDet);
+    const int cLength = liftedTerm(ab, cdx, cdy, cDet);
+    const int abLength = fastExpansionSumZeroElim(aLength, aDet, bLength, bDet, abDet);
+    const int finLength = fastExpansionSumZeroElim(abLength, abDet, cLength, cDet, fin);
+
+    double det = estimateExpansion(finLength, fin);
+    double errorBound = IncircleErrorBoundB * permanent;
+    if (det >= errorBound || -det >= errorBound) {
+        return det;
+    }
+
+    double adxTail = 0.0;
+    double bdxTail = 0.0;
+    double cdxTail = 0.0;
+    double adyTail = 0.0;
+    double bdyTail = 0.0;
+    double cdyTail = 0.0;
+    twoDiffTail(ax, dx, adx, adxTail);
+    twoDiffTail(ay, dy, ady, adyTail);
+    twoDiffTail(bx, dx, bdx, bdxTail);
+    twoDiffTail(by, dy, bdy, bdyTail);
+    twoDiffTail(cx, dx, cdx, cdxTail);
+    twoDiffTail(cy, dy, cdy, cdyTail);
+    if (adxTail == 0.0 && bdxTail == 0.0 && cdxTail == 0.0 &&
+        adyTail == 0.0 && bdyTail == 0.0 && cdyTail == 0.0) {
+        return det;
+    }
+
+    // Stage C: first-order correction by the tails of the differences.
+    errorBound = IncircleErrorBoundC * permanent + ResultErrorBound * std::fabs(det);
+    det += ((adx * adx + ady * ady) * ((bdx * cdyTail + cdy * bdxTail) - (bdy * cdxTail + cdx * bdyTail))
+            + 2.0 * (adx * adxTail + ady * adyTail) * (bdx * cdy - bdy * cdx))
+         + ((bdx * bdx + bdy * bdy) * ((cdx * adyTail + ady * cdxTail) - (cdy * adxTail + adx * cdyTail))
+            + 2.0 * (bdx * bdxTail + bdy * bdyTail) * (cdx * ady - cdy * adx))
+         + ((cdx * cdx + cdy * cdy) * ((adx * bdyTail + bdy * adxTail) - (ady * bdxTail + bdx * adyTail))
+            + 2.0 * (cdx * cdxTail + cdy * cdyTail) * (adx * bdy - ady * bdx));
+    if (det >= errorBound || -det >= errorBound) {
+        return det;
+    }
+
+    // Stage D: exact expansion over the original coordinates.
+    return incircleExact(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+// Positive when d lies inside the circle through the counter-clockwise triangle a, b, c.
+inline double incircleRobust(double ax, double ay, double bx, double by,
+                             double cx, double cy, double dx, double dy) {
+    const double adx = ax - dx;
+    const double bdx = bx - dx;
+    const double cdx = cx - dx;
+    const double ady = ay - dy;
+    const double bdy = by - dy;
+    const double cdy = cy - dy;
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+    const double aLift = adx * adx + ady * ady;
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double bLift = bdx * bdx + bdy * bdy;
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+    const double cLift = cdx * cdx + cdy * cdy;
+
+    const double det = aLift * (bdxcdy - cdxbdy)
+                     + bLift * (cdxady - adxcdy)
+                     + cLift * (adxbdy - bdxady);
+    const double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * aLift
+                           + (std::fabs(cdxady) + std::fabs(adxcdy)) * bLift
+                           + (std::fabs(adxbdy) + std::fabs(bdxady)) * cLift;
+    const double errorBound = IncircleErrorBoundA * permanent;
+    if (det > errorBound || -det > errorBound) {
+        return det;
+    }
+    return incircleAdaptive(ax, ay, bx, by, cx, cy, dx, dy, permanent);
+}
+
+// Error bounds of the double filter for scalars other than double. Coordinates are converted to
+// double with a relative error of up to 16 ulps, so the permanent is taken over |a| + |b| instead
+// of |a - b| and the constants absorb the conversion error of every coordinate.
+constexpr double OrientationFilterBoundRounded = 40.0 * DoubleRoundoff;
+constexpr double IncircleFilterBoundRounded = 80.0 * DoubleRoundoff;
+
+// The rounded-input bounds only hold while every term stays in the normal double range.
+inline bool filterMagnitudeInRange(double magnitude, double limit) {
+    return magnitude == 0.0 || (magnitude >= 1.0 / limit && magnitude <= limit);
+}
+
+template <typename Scalar>
+int exactOrientationSign(const Point2D<Scalar>& a,
+                         const Point2D<Scalar>& b,
+                         const Point2D<Scalar>& c) {
+    if constexpr (std::is_same_v<Scalar, ExactScalar>) {
+        return signOf(orientationDet(a, b, c));
+    } else {
+        const Point2D<ExactScalar> ea{toExact(a.x), toExact(a.y)};
+        const Point2D<ExactScalar> eb{toExact(b.x), toExact(b.y)};
+        const Point2D<ExactScalar> ec{toExact(c.x), toExact(c.y)};
+        return signOf(orientationDet(ea, eb, ec));
+    }
+}
+
+template <typename Scalar>
+ExactScalar incircleDet(const Point2D<Scalar>& a,
+                        const Point2D<Scalar>& b,
+                        const Point2D<Scalar>& c,
+                        const Point2D<Scalar>& d) {
+    const ExactScalar adx = toExact(a.x) - toExact(d.x);
+    const ExactScalar ady = toExact(a.y) - toExact(d.y);
+    const ExactScalar bdx = toExact(b.x) - toExact(d.x);
+    const ExactScalar bdy = toExact(b.y) - toExact(d.y);
+    const ExactScalar cdx = toExact(c.x) - toExact(d.x);
+    const ExactScalar cdy = toExact(c.y) - toExact(d.y);
+    return (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy)
+         + (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy)
+         + (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+}
+
+// Sign of orient2d(a, b, c): +1 when c lies to the left of a->b. Double input goes through the
+// adaptive expansion predicate; other scalars are evaluated in double first and recomputed in
+// ExactScalar only when the double result is within the error bound.
+template <typename Scalar>
+int filteredOrientationSign(const Point2D<Scalar>& a,
+                            const Point2D<Scalar>& b,
+                            const Point2D<Scalar>& c) {
+    if constexpr (std::is_same_v<Scalar, double>) {
+        const double det = orient2dRobust(a.x, a.y, b.x, b.y, c.x, c.y);
+        if (!std::isfinite(det)) {
+            return exactOrientationSign(a, b, c);
+        }
+        return signOf(det);
+    } else {
+        const double ax = toDouble(a.x);
+        const double ay = toDouble(a.y);
+        const double bx = toDouble(b.x);
+        const double by = toDouble(b.y);
+        const double cx = toDouble(c.x);
+        const double cy = toDouble(c.y);
+
+        constexpr double Limit = 1e150;
+        const double sx1 = std::fabs(ax) + std::fabs(bx);
+        const double sy1 = std::fabs(ay) + std::fabs(cy);
+        const double sy2 = std::fabs(ay) + std::fabs(by);
+        const double sx2 = std::fabs(ax) + std::fabs(cx);
+        if (!filterMagnitudeInRange(sx1, Limit) || !filterMagnitudeInRange(sy1, Limit) ||
+            !filterMagnitudeInRange(sy2, Limit) || !filterMagnitudeInRange(sx2, Limit)) {
+            return exactOrientationSign(a, b, c);
+        }
+
+        const double det = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+        const double bound = OrientationFilterBoundRounded * (sx1 * sy1 + sy2 * sx2);
+        if (det > bound || -det > bound) {
+            return det > 0.0 ? 1 : -1;
+        }
+        return exactOrientationSign(a, b, c);
+    }
+}
+
+// Sign of incircle(a, b, c, d): +1 when d lies inside the circle through a, b, c given in
+// counter-clockwise order (the sign flips for clockwise input).
+template <typename Scalar>
+int filteredIncircleSign(const Point2D<Scalar>& a,
+                         const Point2D<Scalar>& b,
+                         const Point2D<Scalar>& c,
+                         const Point2D<Scalar>& d) {
+    if constexpr (std::is_same_v<Scalar, double>) {
+        const double det = incircleRobust(a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y);
+        if (!std::isfinite(det)) {
+            return signOf(incircleDet(a, b, c, d));
+        }
+        return signOf(det);
+    } else {
+        const double dx = toDouble(d.x);
+        const double dy = toDouble(d.y);
+        const double adx = toDouble(a.x) - dx;
+        const double ady = toDouble(a.y) - dy;
+        const double bdx = toDouble(b.x) - dx;
+        const double bdy = toDouble(b.y) - dy;
+        const double cdx = toDouble(c.x) - dx;
+        const double cdy = toDouble(c.y) - dy;
+
+        constexpr double Limit = 1e75;
+        const double adxSum = std::fabs(toDouble(a.x)) + std::fabs(dx);
+        const double adySum = std::fabs(toDouble(a.y)) + std::fabs(dy);
+        const double bdxSum = std::fabs(toDouble(b.x)) + std::fabs(dx);
+        const double bdySum = std::fabs(toDouble(b.y)) + std::fabs(dy);
+        const double cdxSum = std::fabs(toDouble(c.x)) + std::fabs(dx);
+        const double cdySum = std::fabs(toDouble(c.y)) + std::fabs(dy);
+        for (const double magnitude : {adxSum, adySum, bdxSum, bdySum, cdxSum, cdySum}) {
+            if (!filterMagnitudeInRange(magnitude, Limit)) {
+                return signOf(incircleDet(a, b, c, d));
+            }
+        }
+
+        const double det = (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy)
+                         + (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy)
+                         + (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+        const double permanent = (bdxSum * cdySum + cdxSum * bdySum) * (adxSum * adxSum + adySum * adySum)
+                               + (cdxSum * adySum + adxSum * cdySum) * (bdxSum * bdxSum + bdySum * bdySum)
+                               + (adxSum * bdySum + bdxSum * adySum) * (cdxSum * cdxSum + cdySum * cdySum);
+        const double bound = IncircleFilterBoundRounded * permanent;
+        if (det > bound || -det > bound) {
+            return det > 0.0 ? 1 : -1;
+        }
+        return signOf(incircleDet(a, b, c, d));
+    }
+}
+
+// Orientation sign under the selected kernel. With the tolerance kernel the determinant is
+// treated as zero while |det| <= tolerance; the filtered kernel ignores the tolerance.
+template <typename Scalar>
+inline int orientationSign(const Point2D<Scalar>& a,
+                           const Point2D<Scalar>& b,
+                           const Point2D<Scalar>& c,
+                           const Scalar& tolerance,
+                           PredicateKernel kernel) {
+    if (kernel == PredicateKernel::Filtered) {
+        return filteredOrientationSign(a, b, c);
+    }
+    const Scalar det = orientationDet(a, b, c);
+    if (det > tolerance) {
+        return 1;
+    }
+    if (det < -tolerance) {
+        return -1;
+    }
+    return 0;
+}
+
+// Exact position of c relative to the segment [a, b] once the three points are known to be
+// collinear: -1 before a, 0 on the closed segment, +1 beyond b.
+template <typename Scalar>
+inline int collinearPosition(const Point2D<Scalar>& a,
+                             const Point2D<Scalar>& b,
+                             const Point2D<Scalar>& c) {
+    const bool useX = absValue(b.x - a.x) >= absValue(b.y - a.y);
+    const Scalar& from = useX ? a.x : a.y;
+    const Scalar& to = useX ? b.x : b.y;
+    const Scalar& value = useX ? c.x : c.y;
+    const bool increasing = from <= to;
+    if (increasing ? value < from : value > from) {
+        return -1;
+    }
+    if (increasing ? value > to : value < to) {
+        return 1;
+    }
+    return 0;
+}
+
+template <typename Scalar>
+inline bool lexLessExact(const Point2D<Scalar>& lhs, const Point2D<Scalar>& rhs) {
+    if (lhs.x != rhs.x) {
+        return lhs.x < rhs.x;
+    }
+    return lhs.y < rhs.y;
+}
+
+template <typename Scalar>
+inline bool pointsIdentical(const Point2D<Scalar>& lhs, const Point2D<Scalar>& rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
 template <typename Scalar>
 inline Scalar signedArea(const Polygon<Scalar>& polygon) {
     Scalar area = Scalar{};
@@ -127,7 +853,8 @@ Polygon<Scalar> removeDuplicateVertices(const Polygon<Scalar>& polygon,
 
 template <typename Scalar>
 Polygon<Scalar> removeColinearSpikes(const Polygon<Scalar>& polygon,
-                                     const Scalar& eps) {
+                                     const Scalar& eps,
+                                     PredicateKernel kernel = PredicateKernel::Tolerance) {
     if (polygon.size() <= 2) {
         return polygon;
     }
@@ -140,8 +867,7 @@ Polygon<Scalar> removeColinearSpikes(const Polygon<Scalar>& polygon,
         const auto& prev = polygon[(i + n - 1) % n];
         const auto& current = polygon[i];
         const auto& next = polygon[(i + 1) % n];
-        const Scalar orient = orientationDet(prev, current, next);
-        if (absValue(orient) <= eps) {
+        if (orientationSign(prev, current, next, eps, kernel) == 0) {
             const auto v1 = subtract(current, prev);
             const auto v2 = subtract(next, current);
             if (dot(v1, v2) > Scalar{}) {
@@ -161,13 +887,15 @@ Polygon<Scalar> removeColinearSpikes(const Polygon<Scalar>& polygon,
 }
 
 template <typename Scalar>
-Polygon<Scalar> cleanupPolygon(Polygon<Scalar> polygon, const Scalar& eps) {
+Polygon<Scalar> cleanupPolygon(Polygon<Scalar> polygon,
+                               const Scalar& eps,
+                               PredicateKernel kernel = PredicateKernel::Tolerance) {
     polygon = removeDuplicateVertices(polygon, eps);
     if (polygon.size() < 3) {
         return polygon;
     }
 
-    polygon = removeColinearSpikes(polygon, eps);
+    polygon = removeColinearSpikes(polygon, eps, kernel);
     if (polygon.size() < 3) {
         return {};
     }
@@ -203,13 +931,14 @@ Polygon<Scalar> normalizePolygon(const Polygon<Scalar>& polygon, const Scalar& e
 template <typename Scalar>
 bool polygonContainsPoint(const Polygon<Scalar>& polygon,
                           const Point2D<Scalar>& point,
-                          const Scalar& eps) {
+                          const Scalar& eps,
+                          PredicateKernel kernel = PredicateKernel::Tolerance) {
     const std::size_t n = polygon.size();
     if (n < 3) {
         return false;
     }
     for (std::size_t i = 0; i < n; ++i) {
-        if (orientationDet(polygon[i], polygon[(i + 1) % n], point) < -eps) {
+        if (orientationSign(polygon[i], polygon[(i + 1) % n], point, eps, kernel) < 0) {
             return false;
         }
     }
@@ -219,12 +948,13 @@ bool polygonContainsPoint(const Polygon<Scalar>& polygon,
 template <typename Scalar>
 bool polygonContainsPolygon(const Polygon<Scalar>& outer,
                             const Polygon<Scalar>& inner,
-                            const Scalar& eps) {
+                            const Scalar& eps,
+                            PredicateKernel kernel = PredicateKernel::Tolerance) {
     if (inner.empty()) {
         return true;
     }
     for (const auto& point : inner) {
-        if (!polygonContainsPoint(outer, point, eps)) {
+        if (!polygonContainsPoint(outer, point, eps, kernel)) {
             return false;
         }
     }
@@ -234,14 +964,15 @@ bool polygonContainsPolygon(const Polygon<Scalar>& outer,
 template <typename Scalar>
 bool polygonsDoNotOverlap(const Polygon<Scalar>& A,
                           const Polygon<Scalar>& B,
-                          const Scalar& eps) {
+                          const Scalar& eps,
+                          PredicateKernel kernel = PredicateKernel::Tolerance) {
     for (const auto& point : A) {
-        if (polygonContainsPoint(B, point, eps)) {
+        if (polygonContainsPoint(B, point, eps, kernel)) {
             return false;
         }
     }
     for (const auto& point : B) {
-        if (polygonContainsPoint(A, point, eps)) {
+        if (polygonContainsPoint(A, point, eps, kernel)) {
             return false;
         }
     }
@@ -252,7 +983,7 @@ bool polygonsDoNotOverlap(const Polygon<Scalar>& A,
         const Segment2D<Scalar> edgeA{A[i], A[(i + 1) % nA]};
         for (std::size_t j = 0; j < nB; ++j) {
             const Segment2D<Scalar> edgeB{B[j], B[(j + 1) % nB]};
-            const auto result = intersectSegments(edgeA, edgeB, eps);
+            const auto result = intersectSegments(edgeA, edgeB, eps, kernel);
             if (result.type != IntersectionType::None) {
                 return false;
             }
@@ -265,7 +996,15 @@ template <typename Scalar>
 bool pointOnSegment(const Point2D<Scalar>& point,
                     const Point2D<Scalar>& start,
                     const Point2D<Scalar>& end,
-                    const Scalar& eps) {
+                    const Scalar& eps,
+                    PredicateKernel kernel = PredicateKernel::Tolerance) {
+    if (kernel == PredicateKernel::Filtered) {
+        if (pointsIdentical(start, end)) {
+            return pointsIdentical(point, start);
+        }
+        return filteredOrientationSign(start, end, point) == 0 &&
+               collinearPosition(start, end, point) == 0;
+    }
     const auto segment = subtract(end, start);
     const Scalar lengthSquared = squaredLength(segment);
     if (lengthSquared <= eps * eps) {
@@ -283,6 +1022,24 @@ bool pointOnSegment(const Point2D<Scalar>& point,
     return true;
 }
 
+// Side of point relative to the directed edge for point location: the filtered kernel is
+// exact, the tolerance kernel treats the cross product as zero within crossTolerance.
+template <typename Scalar>
+int edgeSide(const Point2D<Scalar>& start,
+             const Point2D<Scalar>& end,
+             const Point2D<Scalar>& point,
+             const Scalar& eps,
+             PredicateKernel kernel) {
+    if (kernel == PredicateKernel::Filtered) {
+        return filteredOrientationSign(start, end, point);
+    }
+    const auto edge = subtract(end, start);
+    const auto toPoint = subtract(point, start);
+    const Scalar crossValue = cross(edge, toPoint);
+    const Scalar tolerance = crossTolerance(eps, squaredLength(edge), squaredLength(toPoint));
+    return crossValue > tolerance ? 1 : (crossValue < -tolerance ? -1 : 0);
+}
+
 template <typename Scalar>
 inline bool isInsideHalfPlane(const Point2D<Scalar>& edgeStart,
                               const Point2D<Scalar>& edgeEnd,
@@ -334,14 +1091,105 @@ void appendUniquePoint(std::vector<Point2D<Scalar>>& container,
     container.push_back(point);
 }
 
+// Maps points to vertex ids, merging points within eps under pointsEqual in expected O(1).
+// Points are bucketed into a grid of cells 2 * eps wide, so a match always lies in the 3x3
+// block around the query cell. Among several matches the earliest id wins, exactly as a linear
+// scan over the welded points would pick.
+template <typename Scalar>
+class VertexWelder {
+public:
+    explicit VertexWelder(const Scalar& eps, std::size_t expectedPoints = 0)
+        : m_eps(eps),
+          m_cellSize(eps > Scalar{} ? 2.0 * toDouble(eps) : 1.0) {
+        if (!(m_cellSize > 0.0) || !std::isfinite(m_cellSize)) {
+            m_cellSize = 1.0;
+        }
+        m_points.reserve(expectedPoints);
+        m_cells.reserve(expectedPoints);
+    }
+
+    // Id of the first welded point equal to point, or a new id when there is none.
+    std::size_t weld(const Point2D<Scalar>& point) {
+        const std::int64_t cellX = cellOf(point.x);
+        const std::int64_t cellY = cellOf(point.y);
+        std::size_t match = m_points.size();
+        for (std::int64_t dx = -1; dx <= 1; ++dx) {
+            for (std::int64_t dy = -1; dy <= 1; ++dy) {
+                const auto cell = m_cells.find(CellKey{cellX + dx, cellY + dy});
+                if (cell == m_cells.end()) {
+                    continue;
+                }
+                for (const auto id : cell->second) {
+                    if (id < match && pointsEqual(m_points[id], point, m_eps)) {
+                        match = id;
+                    }
+                }
+            }
+        }
+        if (match == m_points.size()) {
+            m_points.push_back(point);
+            m_cells[CellKey{cellX, cellY}].push_back(match);
+        }
+        return match;
+    }
+
+    const std::vector<Point2D<Scalar>>& points() const {
+        return m_points;
+    }
+
+    std::size_t size() const {
+        return m_points.size();
+    }
+
+private:
+    struct CellKey {
+        std::int64_t x;
+        std::int64_t y;
+
+        bool operator==(const CellKey& other) const {
+            return x == other.x && y == other.y;
+        }
+    };
+
+    struct CellHash {
+        std::size_t operator()(const CellKey& key) const {
+            std::uint64_t h = static_cast<std::uint64_t>(key.x) * 0x9E3779B97F4A7C15ull;
+            h ^= static_cast<std::uint64_t>(key.y) + 0x7F4A7C159E3779B9ull + (h << 6) + (h >> 2);
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+    };
+
+    // Cells beyond the int64 range are clamped; the clamped cells only hold more candidates.
+    std::int64_t cellOf(const Scalar& value) const {
+        constexpr double Limit = 4.0e18;
+        const double cell = std::floor(toDouble(value) / m_cellSize);
+        if (!(cell > -Limit)) {
+            return static_cast<std::int64_t>(-Limit);
+        }
+        if (!(cell < Limit)) {
+            return static_cast<std::int64_t>(Limit);
+        }
+        return static_cast<std::int64_t>(cell);
+    }
+
+    Scalar m_eps;
+    double m_cellSize;
+    std::vector<Point2D<Scalar>> m_points;
+    std::unordered_map<CellKey, std::vector<std::size_t>, CellHash> m_cells;
+};
+
 template <typename Scalar>
 Polygon<Scalar> convexHullFromPoints(std::vector<Point2D<Scalar>> points,
-                                     const Scalar& eps) {
+                                     const Scalar& eps,
+                                     PredicateKernel kernel = PredicateKernel::Tolerance) {
     if (points.size() <= 1) {
         return points;
     }
     std::sort(points.begin(), points.end(),
               [&](const auto& lhs, const auto& rhs) {
+                  if (kernel == PredicateKernel::Filtered) {
+                      return lexLessExact(lhs, rhs);
+                  }
                   if (absValue(lhs.x - rhs.x) > eps) {
                       return lhs.x < rhs.x;
                   }
@@ -361,7 +1209,7 @@ Polygon<Scalar> convexHullFromPoints(std::vector<Point2D<Scalar>> points,
     std::vector<Point2D<Scalar>> lower;
     lower.reserve(points.size());
     for (const auto& point : points) {
-        while (lower.size() >= 2 && orientationDet(lower[lower.size() - 2], lower.back(), point) <= eps) {
+        while (lower.size() >= 2 && orientationSign(lower[lower.size() - 2], lower.back(), point, eps, kernel) <= 0) {
             lower.pop_back();
         }
         lower.push_back(point);
@@ -369,7 +1217,7 @@ Polygon<Scalar> convexHullFromPoints(std::vector<Point2D<Scalar>> points,
     std::vector<Point2D<Scalar>> upper;
     upper.reserve(points.size());
     for (auto it = points.rbegin(); it != points.rend(); ++it) {
-        while (upper.size() >= 2 && orientationDet(upper[upper.size() - 2], upper.back(), *it) <= eps) {
+        while (upper.size() >= 2 && orientationSign(upper[upper.size() - 2], upper.back(), *it, eps, kernel) <= 0) {
             upper.pop_back();
         }
         upper.push_back(*it);
@@ -380,156 +1228,3646 @@ Polygon<Scalar> convexHullFromPoints(std::vector<Point2D<Scalar>> points,
     hull.reserve(lower.size() + upper.size());
     hull.insert(hull.end(), lower.begin(), lower.end());
     hull.insert(hull.end(), upper.begin(), upper.end());
-    return cleanupPolygon(hull, eps);
+    return cleanupPolygon(hull, eps, kernel);
 }
 
 template <typename Scalar>
-struct IntersectionInfo {
-    Point2D<Scalar> point;
-    std::size_t edgeIndexA{};
-    Scalar parameterA{};
-    std::size_t edgeIndexB{};
-    Scalar parameterB{};
-};
-
-template <typename Scalar>
-std::vector<IntersectionInfo<Scalar>> collectIntersections(const Polygon<Scalar>& A,
-                                                           const Polygon<Scalar>& B,
-                                                           const Scalar& eps) {
-    std::vector<IntersectionInfo<Scalar>> intersections;
-    const std::size_t nA = A.size();
-    const std::size_t nB = B.size();
+SegmentIntersectionResult<Scalar> intersectSegmentsFiltered(const Segment2D<Scalar>& first,
+                                                            const Segment2D<Scalar>& second) {
+    SegmentIntersectionResult<Scalar> result{};
+    const auto& p0 = first.start;
+    const auto& p1 = first.end;
+    const auto& q0 = second.start;
+    const auto& q1 = second.end;
 
-    for (std::size_t i = 0; i < nA; ++i) {
-        const Segment2D<Scalar> edgeA{A[i], A[(i + 1) % nA]};
-        for (std::size_t j = 0; j < nB; ++j) {
-            const Segment2D<Scalar> edgeB{B[j], B[(j + 1) % nB]};
-            const auto result = intersectSegments(edgeA, edgeB, eps);
-            if (result.type == IntersectionType::None) {
-                continue;
-            }
-            auto addPoint = [&](const Point2D<Scalar>& point) {
-                for (const auto& existing : intersections) {
-                    if (pointsEqual(existing.point, point, eps)) {
-                        return;
-                    }
-                }
-                IntersectionInfo<Scalar> info;
-                info.point = point;
-                info.edgeIndexA = i;
-                info.edgeIndexB = j;
-                const auto computeParam = [&](const Segment2D<Scalar>& edge) {
-                    const auto edgeVec = subtract(edge.end, edge.start);
-                    const Scalar lengthSquared = squaredLength(edgeVec);
-                    if (lengthSquared <= eps * eps) {
-                        return Scalar{};
-                    }
-                    const auto toPoint = subtract(point, edge.start);
-                    return dot(toPoint, edgeVec) / lengthSquared;
-                };
-                info.parameterA = computeParam(edgeA);
-                info.parameterB = computeParam(edgeB);
-                if (info.parameterA < -eps || info.parameterA > Scalar{1} + eps ||
-                    info.parameterB < -eps || info.parameterB > Scalar{1} + eps) {
-                    return;
-                }
-                intersections.push_back(info);
-            };
+    if (pointsIdentical(p0, p1)) {
+        if (pointOnSegment(p0, q0, q1, Scalar{}, PredicateKernel::Filtered)) {
+            result.type = IntersectionType::Point;
+            result.point = p0;
+        }
+        return result;
+    }
 
-            if (result.type == IntersectionType::Point) {
-                addPoint(result.point);
-            } else if (result.type == IntersectionType::Overlap) {
-                addPoint(result.overlap.start);
-                addPoint(result.overlap.end);
-            }
+    const int o1 = filteredOrientationSign(p0, p1, q0);
+    const int o2 = filteredOrientationSign(p0, p1, q1);
+
+    if (o1 == 0 && o2 == 0) {
+        // Collinear: order everything along the dominant axis of the first segment.
+        const bool useX = absValue(p1.x - p0.x) >= absValue(p1.y - p0.y);
+        const bool increasing = useX ? p0.x < p1.x : p0.y < p1.y;
+        const auto before = [&](const Point2D<Scalar>& lhs, const Point2D<Scalar>& rhs) {
+            const Scalar& l = useX ? lhs.x : lhs.y;
+            const Scalar& r = useX ? rhs.x : rhs.y;
+            return increasing ? l < r : l > r;
+        };
+        const bool secondReversed = before(q1, q0);
+        const Point2D<Scalar>& secondLow = secondReversed ? q1 : q0;
+        const Point2D<Scalar>& secondHigh = secondReversed ? q0 : q1;
+        const Point2D<Scalar>& overlapStart = before(p0, secondLow) ? secondLow : p0;
+        const Point2D<Scalar>& overlapEnd = before(secondHigh, p1) ? secondHigh : p1;
+        if (before(overlapEnd, overlapStart)) {
+            return result;
+        }
+        if (!before(overlapStart, overlapEnd)) {
+            result.type = IntersectionType::Point;
+            result.point = overlapStart;
+            return result;
         }
+        result.type = IntersectionType::Overlap;
+        result.overlap.start = overlapStart;
+        result.overlap.end = overlapEnd;
+        return result;
     }
 
-    return intersections;
-}
+    if (o1 * o2 > 0) {
+        return result;
+    }
+    const int o3 = filteredOrientationSign(q0, q1, p0);
+    const int o4 = filteredOrientationSign(q0, q1, p1);
+    if (o3 * o4 > 0) {
+        return result;
+    }
 
-template <typename Scalar>
-std::vector<Point2D<Scalar>> collectIntersectionPoints(const Polygon<Scalar>& A,
-                                                       const Polygon<Scalar>& B,
-                                                       const Scalar& eps) {
-    std::vector<Point2D<Scalar>> points;
-    const auto info = collectIntersections(A, B, eps);
-    for (const auto& item : info) {
-        appendUniquePoint(points, item.point, eps);
+    result.type = IntersectionType::Point;
+    if (o1 == 0) {
+        result.point = q0;
+    } else if (o2 == 0) {
+        result.point = q1;
+    } else if (o3 == 0) {
+        result.point = p0;
+    } else if (o4 == 0) {
+        result.point = p1;
+    } else {
+        const auto r = subtract(p1, p0);
+        const auto s = subtract(q1, q0);
+        const Scalar denom = cross(r, s);
+        Scalar t = denom != Scalar{} ? cross(subtract(q0, p0), s) / denom : Scalar{0.5};
+        t = std::min(std::max(t, Scalar{}), Scalar{1});
+        result.point = {p0.x + t * r.x, p0.y + t * r.y};
     }
-    return points;
+    return result;
 }
 
+
+// O'Rourke's chasing edges: the current edges of the two CCW convex polygons advance in turn so
+// that each pair of boundary crossings is met once, in O(n + m). The returned boundary of the
+// intersection is uncleaned; an empty result means the boundaries never properly crossed, and
+// the caller decides between containment and disjointness.
 template <typename Scalar>
-struct EdgeKey {
-    Point2D<Scalar> u;
-    Point2D<Scalar> v;
+Polygon<Scalar> chaseConvexIntersection(const Polygon<Scalar>& A,
+                                        const Polygon<Scalar>& B,
+                                        const Scalar& eps,
+                                        PredicateKernel kernel = PredicateKernel::Tolerance) {
+    enum class Inside { Unknown, A, B };
 
-    bool operator<(const EdgeKey& other) const {
-        if (lexLess(u, other.u)) {
-            return true;
+    const std::size_t nA = A.size();
+    const std::size_t nB = B.size();
+    Polygon<Scalar> boundary;
+    const auto emit = [&](const Point2D<Scalar>& point) {
+        if (boundary.empty() || !pointsEqual(boundary.back(), point, eps)) {
+            boundary.push_back(point);
         }
-        if (lexLess(other.u, u)) {
-            return false;
+    };
+
+    const Point2D<Scalar> origin{};
+    Inside inside = Inside::Unknown;
+    std::size_t a = 0;
+    std::size_t b = 0;
+    std::size_t advancedA = 0;
+    std::size_t advancedB = 0;
+    const auto advanceA = [&] {
+        if (inside == Inside::A) {
+            emit(A[a]);
         }
-        return lexLess(v, other.v);
-    }
-};
+        ++advancedA;
+        a = (a + 1) % nA;
+    };
+    const auto advanceB = [&] {
+        if (inside == Inside::B) {
+            emit(B[b]);
+        }
+        ++advancedB;
+        b = (b + 1) % nB;
+    };
 
-template <typename Scalar>
-EdgeKey<Scalar> makeEdge(const Point2D<Scalar>& a, const Point2D<Scalar>& b) {
-    EdgeKey<Scalar> edge{a, b};
-    if (lexLess(edge.v, edge.u)) {
-        std::swap(edge.u, edge.v);
+    do {
+        const auto& headA = A[a];
+        const auto& tailA = A[(a + nA - 1) % nA];
+        const auto& headB = B[b];
+        const auto& tailB = B[(b + nB - 1) % nB];
+        const auto edgeA = subtract(headA, tailA);
+        const auto edgeB = subtract(headB, tailB);
+        const int turn = orientationSign(origin, edgeA, edgeB, eps, kernel);
+        const int headAToB = orientationSign(tailB, headB, headA, eps, kernel);
+        const int headBToA = orientationSign(tailA, headA, headB, eps, kernel);
+
+        const auto result = intersectSegments(Segment2D<Scalar>{tailA, headA}, Segment2D<Scalar>{tailB, headB},
+                                              eps, kernel);
+        if (result.type == IntersectionType::Point) {
+            const Inside previous = inside;
+            if (headAToB > 0) {
+                inside = Inside::A;
+            } else if (headBToA > 0) {
+                inside = Inside::B;
+            }
+            if (previous == Inside::Unknown && inside != Inside::Unknown) {
+                // First real crossing: restart the counts so that the loop closes back here.
+                boundary.clear();
+                advancedA = 0;
+                advancedB = 0;
+            }
+            emit(result.point);
+        } else if (result.type == IntersectionType::Overlap && dot(edgeA, edgeB) < Scalar{}) {
+            // Opposite collinear edges: the polygons only share that edge.
+            return {};
+        }
+
+        if (turn == 0 && headAToB < 0 && headBToA < 0) {
+            // Parallel edges facing away from each other: the polygons are disjoint.
+            return {};
+        }
+        if (turn == 0 && headAToB == 0 && headBToA == 0) {
+            // Collinear edges running the same way: advance the one lagging behind.
+            if (inside == Inside::A) {
+                advanceB();
+            } else {
+                advanceA();
+            }
+        } else if (turn >= 0) {
+            if (headBToA > 0) {
+                advanceA();
+            } else {
+                advanceB();
+            }
+        } else if (headAToB > 0) {
+            advanceB();
+        } else {
+            advanceA();
+        }
+    } while ((advancedA < nA || advancedB < nB) && advancedA < 2 * nA && advancedB < 2 * nB);
+
+    if (inside == Inside::Unknown) {
+        return {};
     }
-    return edge;
+    return boundary;
 }
 
 template <typename Scalar>
-std::array<Point2D<Scalar>, 3> makeSuperTriangle(const std::vector<Point2D<Scalar>>& points) {
-    Scalar minX = points.front().x;
-    Scalar maxX = points.front().x;
-    Scalar minY = points.front().y;
-    Scalar maxY = points.front().y;
-
-    for (const auto& point : points) {
-        minX = std::min(minX, point.x);
-        maxX = std::max(maxX, point.x);
-        minY = std::min(minY, point.y);
-        maxY = std::max(maxY, point.y);
+bool isPointInsideCircumcircle(const Point2D<Scalar>& a,
+                               const Point2D<Scalar>& b,
+                               const Point2D<Scalar>& c,
+                               const Point2D<Scalar>& point,
+                               PredicateKernel kernel = PredicateKernel::Tolerance) {
+    if (kernel == PredicateKernel::Filtered) {
+        const int orient = filteredOrientationSign(a, b, c);
+        return orient != 0 && filteredIncircleSign(a, b, c, point) == orient;
     }
 
-    const Scalar dx = maxX - minX;
-    const Scalar dy = maxY - minY;
-    const Scalar delta = std::max(dx, dy);
-    const Scalar midX = (minX + maxX) / Scalar{2};
-    const Scalar midY = (minY + maxY) / Scalar{2};
-    const Scalar radius = std::max(delta, Scalar{1}) * Scalar{20};
-
-    return {Point2D<Scalar>{midX - radius, midY - radius},
-            Point2D<Scalar>{midX, midY + radius},
-            Point2D<Scalar>{midX + radius, midY - radius}};
-}
+    const Scalar ax = a.x - point.x;
+    const Scalar ay = a.y - point.y;
+    const Scalar bx = b.x - point.x;
+    const Scalar by = b.y - point.y;
+    const Scalar cx = c.x - point.x;
+    const Scalar cy = c.y - point.y;
+
+    const Scalar det = (ax * ax + ay * ay) * (bx * cy - cx * by)
+                     - (bx * bx + by * by) * (ax * cy - cx * ay)
+                     + (cx * cx + cy * cy) * (ax * by - bx * ay);
+
+    const Scalar orient = orientationDet(a, b, c);
+    if (orient > Scalar{}) {
+        return det > Scalar{Epsilon};
+    }
+    return det < -Scalar{Epsilon};
+}
+
+template <typename Scalar>
+bool isPointInsideCircumcircle(const Triangle2D<Scalar>& triangle,
+                               const Point2D<Scalar>& point,
+                               PredicateKernel kernel = PredicateKernel::Tolerance) {
+    return isPointInsideCircumcircle(triangle.a, triangle.b, triangle.c, point, kernel);
+}
+
+constexpr std::uint32_t NoIndex = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint32_t GhostVertex = NoIndex - 1;
+constexpr std::uint32_t DefaultTriangulationSeed = 5489u;
+
+// Incremental Delaunay triangulation over an index-based face table. Faces are CCW and
+// neighbors[i] is the face across the edge opposite vertices[i]. The hull is closed by ghost
+// faces sharing GhostVertex, so a point outside the hull is inserted like any other.
+// Until three non-collinear vertices exist the vertices are only recorded as pending.
+template <typename Scalar>
+class Triangulation {
+public:
+    struct Face {
+        std::array<std::uint32_t, 3> vertices{NoIndex, NoIndex, NoIndex};
+        std::array<std::uint32_t, 3> neighbors{NoIndex, NoIndex, NoIndex};
+        std::uint8_t constrained{0};
+        bool alive{false};
+    };
+
+    Triangulation(std::vector<Point2D<Scalar>> points, PredicateKernel kernel, std::uint32_t seed)
+        : m_points(std::move(points)),
+          m_kernel(kernel),
+          m_vertexFace(m_points.size(), NoIndex),
+          m_vertexMark(m_points.size(), 0u),
+          m_insertedIndex(m_points.size(), NoIndex),
+          m_live(m_points.size(), 1),
+          m_generator(seed) {
+        m_approx.reserve(m_points.size());
+        for (const auto& point : m_points) {
+            m_approx.push_back({toDouble(point.x), toDouble(point.y)});
+        }
+    }
+
+    const std::vector<std::array<double, 2>>& approximatePoints() const {
+        return m_approx;
+    }
+
+    // Inserts the vertices in the given order; returns false when they are all collinear.
+    // A spatially coherent order walks from the previous vertex instead of sampling.
+    bool build(const std::vector<std::uint32_t>& order, bool spatiallyOrdered) {
+        if (order.size() < 3) {
+            return false;
+        }
+        std::size_t third = 2;
+        while (third < order.size() && orientation(order[0], order[1], m_points[order[third]]) == 0) {
+            ++third;
+        }
+        if (third == order.size()) {
+            return false;
+        }
+
+        m_faces.reserve(2 * order.size() + 4);
+        m_faceMark.reserve(2 * order.size() + 4);
+        m_inserted.reserve(order.size());
+        m_spatiallyOrdered = spatiallyOrdered;
+        createInitialFaces(order[0], order[1], order[third]);
+        for (std::size_t i = 2; i < order.size(); ++i) {
+            if (i != third) {
+                insert(order[i]);
+            }
+        }
+        return true;
+    }
+
+    bool insert(std::uint32_t vertex) {
+        if (!m_started) {
+            return insertPending(vertex);
+        }
+
+        const Point2D<Scalar>& point = m_points[vertex];
+        const std::uint32_t face = locate(point, jumpStart(m_approx[vertex]));
+        if (face == NoIndex) {
+            return false;
+        }
+        for (const auto corner : m_faces[face].vertices) {
+            if (corner != GhostVertex && pointsIdentical(m_points[corner], point)) {
+                return false;
+            }
+        }
+
+        // The tolerance kernel may disagree with itself near degeneracies; an inconsistent
+        // cavity is recomputed with exact predicates instead of corrupting the mesh.
+        if (!collectCavity(face, point, m_kernel) &&
+            (m_kernel == PredicateKernel::Filtered || !collectCavity(face, point, PredicateKernel::Filtered))) {
+            return false;
+        }
+        fillCavity(vertex);
+        markInserted(vertex);
+        return true;
+    }
+
+    // Appends a vertex slot, reusing released ids; the vertex still has to be inserted.
+    std::uint32_t addVertex(const Point2D<Scalar>& point) {
+        std::uint32_t vertex = 0;
+        if (!m_freeVertices.empty()) {
+            vertex = m_freeVertices.back();
+            m_freeVertices.pop_back();
+            m_points[vertex] = point;
+            m_approx[vertex] = {toDouble(point.x), toDouble(point.y)};
+            m_live[vertex] = 1;
+            return vertex;
+        }
+        if (m_points.size() >= GhostVertex) {
+            throw std::invalid_argument("Triangulation: too many vertices");
+        }
+        vertex = static_cast<std::uint32_t>(m_points.size());
+        m_points.push_back(point);
+        m_approx.push_back({toDouble(point.x), toDouble(point.y)});
+        m_vertexFace.push_back(NoIndex);
+        m_vertexMark.push_back(0u);
+        m_insertedIndex.push_back(NoIndex);
+        m_live.push_back(1);
+        return vertex;
+    }
+
+    void releaseVertex(std::uint32_t vertex) {
+        m_live[vertex] = 0;
+        m_freeVertices.push_back(vertex);
+    }
+
+    bool isLive(std::uint32_t vertex) const {
+        return vertex < m_live.size() && m_live[vertex] != 0;
+    }
+
+    std::size_t liveVertexCount() const {
+        return m_points.size() - m_freeVertices.size();
+    }
+
+    // Removes the vertex from the mesh and retriangulates its star; the id stays allocated.
+    void remove(std::uint32_t vertex) {
+        if (!m_started) {
+            m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), vertex), m_pending.end());
+            return;
+        }
+
+        std::vector<std::uint32_t> ring;
+        std::vector<std::uint32_t> outer;
+        std::vector<std::uint32_t> star;
+        collectStar(vertex, ring, outer, star);
+        for (const auto face : star) {
+            releaseFace(face);
+        }
+        unmarkInserted(vertex);
+        m_vertexFace[vertex] = NoIndex;
+
+        if (!retriangulateHole(ring, outer) || m_solidFaces == 0) {
+            restart();
+        }
+    }
+
+    // Moves a vertex. Stays in place with Lawson flips while the star remains valid, otherwise
+    // removes and reinserts. Returns false, leaving the vertex unchanged, on a coincident target.
+    bool relocate(std::uint32_t vertex, const Point2D<Scalar>& point) {
+        if (pointsIdentical(m_points[vertex], point)) {
+            return true;
+        }
+        if (!m_started) {
+            for (const auto other : m_pending) {
+                if (other != vertex && pointsIdentical(m_points[other], point)) {
+                    return false;
+                }
+            }
+            setPosition(vertex, point);
+            tryStart();
+            return true;
+        }
+
+        const std::uint32_t face = locate(point, m_vertexFace[vertex]);
+        if (face != NoIndex) {
+            for (const auto corner : m_faces[face].vertices) {
+                if (corner != GhostVertex && corner != vertex && pointsIdentical(m_points[corner], point)) {
+                    return false;
+                }
+            }
+        }
+
+        if (starStaysValid(vertex, point)) {
+            setPosition(vertex, point);
+            std::vector<std::uint32_t> ring;
+            std::vector<std::uint32_t> outer;
+            std::vector<std::uint32_t> star;
+            collectStar(vertex, ring, outer, star);
+            restoreDelaunay(star);
+            return true;
+        }
+
+        const Point2D<Scalar> previous = m_points[vertex];
+        remove(vertex);
+        setPosition(vertex, point);
+        if (!insert(vertex)) {
+            setPosition(vertex, previous);
+            insert(vertex);
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<Point2D<Scalar>>& points() {
+        return m_points;
+    }
+
+    const std::vector<Point2D<Scalar>>& points() const {
+        return m_points;
+    }
+
+    // Compacts the solid faces, optionally only the kept ones, into mesh triangles; ghost and
+    // dropped neighbors become NoNeighbor.
+    void exportTopology(TriangleMesh<Scalar>& mesh, const std::vector<unsigned char>* keep = nullptr) const {
+        std::vector<std::uint32_t> remap(m_faces.size(), NoIndex);
+        std::uint32_t count = 0;
+        for (std::uint32_t index = 0; index < m_faces.size(); ++index) {
+            if (m_faces[index].alive && ghostCorner(m_faces[index]) < 0 && (keep == nullptr || (*keep)[index] != 0)) {
+                remap[index] = count++;
+            }
+        }
+
+        mesh.triangles.clear();
+        mesh.neighbors.clear();
+        mesh.triangles.reserve(count);
+        mesh.neighbors.reserve(count);
+        for (std::uint32_t index = 0; index < m_faces.size(); ++index) {
+            if (remap[index] == NoIndex) {
+                continue;
+            }
+            const Face& face = m_faces[index];
+            mesh.triangles.push_back(face.vertices);
+            mesh.neighbors.push_back({remap[face.neighbors[0]], remap[face.neighbors[1]], remap[face.neighbors[2]]});
+        }
+    }
+
+    // Inserts in the given order, keeping vertices pending while they are collinear and
+    // rejecting exact duplicates. Used when the input has not been deduplicated.
+    void insertAll(const std::vector<std::uint32_t>& order) {
+        m_spatiallyOrdered = true;
+        for (const auto vertex : order) {
+            insert(vertex);
+        }
+    }
+
+    bool started() const {
+        return m_started;
+    }
+
+    bool isInserted(std::uint32_t vertex) const {
+        return m_insertedIndex[vertex] != NoIndex;
+    }
+
+    // Returns the inserted vertex at exactly this position, or NoIndex.
+    std::uint32_t findVertex(const Point2D<Scalar>& point) {
+        if (!m_started) {
+            return NoIndex;
+        }
+        const std::uint32_t face = locate(point, jumpStart({toDouble(point.x), toDouble(point.y)}));
+        if (face == NoIndex) {
+            return NoIndex;
+        }
+        for (const auto corner : m_faces[face].vertices) {
+            if (corner != GhostVertex && pointsIdentical(m_points[corner], point)) {
+                return corner;
+            }
+        }
+        return NoIndex;
+    }
+
+    // Forces the segment between two inserted vertices into the mesh as a chain of constrained
+    // edges. The faces crossed by the segment are removed and the two pseudo-polygons on either
+    // side are retriangulated; a vertex on the segment splits it.
+    void insertConstraint(std::uint32_t from, std::uint32_t to) {
+        while (from != to) {
+            from = insertConstraintPiece(from, to);
+        }
+    }
+
+    // Marks faces enclosed by an odd number of constraints, counting from the hull inwards.
+    std::vector<unsigned char> enclosedFaces() const {
+        std::vector<std::uint32_t> depth(m_faces.size(), NoIndex);
+        std::deque<std::uint32_t> queue;
+        for (std::uint32_t index = 0; index < m_faces.size(); ++index) {
+            const Face& face = m_faces[index];
+            if (!face.alive || ghostCorner(face) >= 0) {
+                continue;
+            }
+            for (int corner = 0; corner < 3; ++corner) {
+                if (ghostCorner(m_faces[face.neighbors[corner]]) < 0) {
+                    continue;
+                }
+                const std::uint32_t crossing = isConstrained(face, corner) ? 1u : 0u;
+                if (crossing < depth[index]) {
+                    depth[index] = crossing;
+                    if (crossing == 0) {
+                        queue.push_front(index);
+                    } else {
+                        queue.push_back(index);
+                    }
+                }
+            }
+        }
+
+        while (!queue.empty()) {
+            const std::uint32_t index = queue.front();
+            queue.pop_front();
+            const Face& face = m_faces[index];
+            for (int corner = 0; corner < 3; ++corner) {
+                const std::uint32_t neighbor = face.neighbors[corner];
+                if (ghostCorner(m_faces[neighbor]) >= 0) {
+                    continue;
+                }
+                const std::uint32_t crossing = isConstrained(face, corner) ? 1u : 0u;
+                if (depth[index] + crossing < depth[neighbor]) {
+                    depth[neighbor] = depth[index] + crossing;
+                    if (crossing == 0) {
+                        queue.push_front(neighbor);
+                    } else {
+                        queue.push_back(neighbor);
+                    }
+                }
+            }
+        }
+
+        std::vector<unsigned char> enclosed(m_faces.size(), 0);
+        for (std::uint32_t index = 0; index < m_faces.size(); ++index) {
+            enclosed[index] = depth[index] != NoIndex && (depth[index] & 1u) != 0 ? 1 : 0;
+        }
+        return enclosed;
+    }
+
+private:
+    struct CavityEdge {
+        std::uint32_t u;
+        std::uint32_t w;
+        std::uint32_t outside;
+    };
+
+    static int ghostCorner(const Face& face) {
+        for (int i = 0; i < 3; ++i) {
+            if (face.vertices[i] == GhostVertex) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static int cornerOf(const Face& face, std::uint32_t vertex) {
+        for (int i = 0; i < 3; ++i) {
+            if (face.vertices[i] == vertex) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    int orientation(std::uint32_t u, std::uint32_t w, const Point2D<Scalar>& point) const {
+        return filteredOrientationSign(m_points[u], m_points[w], point);
+    }
+
+    // Conflict test of the ghost face over the directed hull edge (u, w): the open half-plane
+    // left of the edge plus the open edge itself.
+    bool inGhostConflict(std::uint32_t u, std::uint32_t w, const Point2D<Scalar>& point) const {
+        const int side = orientation(u, w, point);
+        if (side != 0) {
+            return side > 0;
+        }
+        return collinearPosition(m_points[u], m_points[w], point) == 0;
+    }
+
+    bool inConflict(std::uint32_t faceIndex, const Point2D<Scalar>& point, PredicateKernel kernel) const {
+        const Face& face = m_faces[faceIndex];
+        const int ghost = ghostCorner(face);
+        if (ghost < 0) {
+            const auto& a = m_points[face.vertices[0]];
+            const auto& b = m_points[face.vertices[1]];
+            const auto& c = m_points[face.vertices[2]];
+            if (kernel == PredicateKernel::Filtered) {
+                return filteredIncircleSign(a, b, c, point) > 0;
+            }
+            return isPointInsideCircumcircle(a, b, c, point, kernel);
+        }
+        return inGhostConflict(face.vertices[(ghost + 1) % 3], face.vertices[(ghost + 2) % 3], point);
+    }
+
+    std::uint32_t allocateFace(const std::array<std::uint32_t, 3>& vertices) {
+        std::uint32_t index = 0;
+        if (!m_freeFaces.empty()) {
+            index = m_freeFaces.back();
+            m_freeFaces.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(m_faces.size());
+            m_faces.emplace_back();
+            m_faceMark.push_back(0u);
+        }
+        Face& face = m_faces[index];
+        face.vertices = vertices;
+        face.neighbors = {NoIndex, NoIndex, NoIndex};
+        face.constrained = 0;
+        face.alive = true;
+        if (ghostCorner(face) < 0) {
+            ++m_solidFaces;
+        }
+        for (const auto corner : vertices) {
+            if (corner != GhostVertex) {
+                m_vertexFace[corner] = index;
+            }
+        }
+        return index;
+    }
+
+    void releaseFace(std::uint32_t index) {
+        Face& face = m_faces[index];
+        face.alive = false;
+        if (ghostCorner(face) < 0) {
+            --m_solidFaces;
+        }
+        m_freeFaces.push_back(index);
+    }
+
+    // Points the neighbor slot of the face that holds the directed edge (u, w) at `neighbor`.
+    void replaceNeighbor(std::uint32_t faceIndex, std::uint32_t u, std::uint32_t w, std::uint32_t neighbor) {
+        Face& face = m_faces[faceIndex];
+        for (int i = 0; i < 3; ++i) {
+            if (face.vertices[(i + 1) % 3] == u && face.vertices[(i + 2) % 3] == w) {
+                face.neighbors[i] = neighbor;
+                return;
+            }
+        }
+    }
+
+    void markInserted(std::uint32_t vertex) {
+        m_insertedIndex[vertex] = static_cast<std::uint32_t>(m_inserted.size());
+        m_inserted.push_back(vertex);
+    }
+
+    void unmarkInserted(std::uint32_t vertex) {
+        const std::uint32_t slot = m_insertedIndex[vertex];
+        const std::uint32_t last = m_inserted.back();
+        m_inserted[slot] = last;
+        m_insertedIndex[last] = slot;
+        m_inserted.pop_back();
+        m_insertedIndex[vertex] = NoIndex;
+    }
+
+    void setPosition(std::uint32_t vertex, const Point2D<Scalar>& point) {
+        m_points[vertex] = point;
+        m_approx[vertex] = {toDouble(point.x), toDouble(point.y)};
+    }
+
+    void createInitialFaces(std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+        if (orientation(a, b, m_points[c]) < 0) {
+            std::swap(b, c);
+        }
+        const std::uint32_t solid = allocateFace({a, b, c});
+        const std::uint32_t ghostA = allocateFace({c, b, GhostVertex});
+        const std::uint32_t ghostB = allocateFace({a, c, GhostVertex});
+        const std::uint32_t ghostC = allocateFace({b, a, GhostVertex});
+        m_faces[solid].neighbors = {ghostA, ghostB, ghostC};
+        m_faces[ghostA].neighbors = {ghostC, ghostB, solid};
+        m_faces[ghostB].neighbors = {ghostA, ghostC, solid};
+        m_faces[ghostC].neighbors = {ghostB, ghostA, solid};
+        m_vertexFace[a] = solid;
+        m_vertexFace[b] = solid;
+        m_vertexFace[c] = solid;
+        m_inserted.clear();
+        markInserted(a);
+        markInserted(b);
+        markInserted(c);
+        m_started = true;
+    }
+
+    bool insertPending(std::uint32_t vertex) {
+        for (const auto other : m_pending) {
+            if (pointsIdentical(m_points[other], m_points[vertex])) {
+                return false;
+            }
+        }
+        m_pending.push_back(vertex);
+        tryStart();
+        return true;
+    }
+
+    // Builds the first triangle once the pending vertices stop being collinear.
+    void tryStart() {
+        if (m_pending.size() < 3) {
+            return;
+        }
+        std::size_t third = 2;
+        while (third < m_pending.size() &&
+               orientation(m_pending[0], m_pending[1], m_points[m_pending[third]]) == 0) {
+            ++third;
+        }
+        if (third == m_pending.size()) {
+            return;
+        }
+
+        std::vector<std::uint32_t> pending;
+        pending.swap(m_pending);
+        createInitialFaces(pending[0], pending[1], pending[third]);
+        for (std::size_t i = 2; i < pending.size(); ++i) {
+            if (i != third) {
+                insert(pending[i]);
+            }
+        }
+    }
+
+    // Drops every face and reinserts the remaining vertices; used when a removal leaves the
+    // vertices collinear or the hole cannot be retriangulated.
+    void restart() {
+        std::vector<std::uint32_t> vertices = m_inserted;
+        m_faces.clear();
+        m_faceMark.clear();
+        m_freeFaces.clear();
+        m_solidFaces = 0;
+        m_faceStamp = 0;
+        for (const auto vertex : vertices) {
+            m_vertexFace[vertex] = NoIndex;
+            m_insertedIndex[vertex] = NoIndex;
+        }
+        m_inserted.clear();
+        m_started = false;
+        m_pending = std::move(vertices);
+        tryStart();
+    }
+
+    // Starts the walk from the closest of ~n^(1/3) sampled vertices and the last inserted one.
+    std::uint32_t jumpStart(const std::array<double, 2>& target) {
+        const auto distance = [&](std::uint32_t candidate) {
+            const double dx = m_approx[candidate][0] - target[0];
+            const double dy = m_approx[candidate][1] - target[1];
+            return dx * dx + dy * dy;
+        };
+
+        std::uint32_t best = m_inserted.back();
+        if (m_spatiallyOrdered) {
+            return m_vertexFace[best];
+        }
+        double bestDistance = distance(best);
+        const auto samples = static_cast<std::size_t>(std::cbrt(static_cast<double>(m_inserted.size())));
+        std::uniform_int_distribution<std::size_t> pick(0, m_inserted.size() - 1);
+        for (std::size_t i = 0; i < samples; ++i) {
+            const std::uint32_t candidate = m_inserted[pick(m_generator)];
+            const double candidateDistance = distance(candidate);
+            if (candidateDistance < bestDistance) {
+                best = candidate;
+                bestDistance = candidateDistance;
+            }
+        }
+        return m_vertexFace[best];
+    }
+
+    std::uint32_t nextRandom() {
+        m_walkState ^= m_walkState << 13;
+        m_walkState ^= m_walkState >> 17;
+        m_walkState ^= m_walkState << 5;
+        return m_walkState;
+    }
+
+    // Visibility walk with a random first edge so it cannot cycle on non-Delaunay meshes.
+    std::uint32_t locate(const Point2D<Scalar>& point, std::uint32_t face) {
+        const int startGhost = ghostCorner(m_faces[face]);
+        if (startGhost >= 0) {
+            face = m_faces[face].neighbors[startGhost];
+        }
+
+        std::uint32_t previous = NoIndex;
+        const std::size_t stepLimit = 4 * m_faces.size() + 64;
+        for (std::size_t step = 0; step < stepLimit; ++step) {
+            const Face& current = m_faces[face];
+            if (ghostCorner(current) >= 0) {
+                return face;
+            }
+
+            const std::uint32_t offset = nextRandom() % 3;
+            std::uint32_t next = NoIndex;
+            for (std::uint32_t k = 0; k < 3; ++k) {
+                const std::uint32_t i = (offset + k) % 3;
+                if (current.neighbors[i] == previous) {
+                    continue;
+                }
+                if (orientation(current.vertices[(i + 1) % 3], current.vertices[(i + 2) % 3], point) < 0) {
+                    next = current.neighbors[i];
+                    break;
+                }
+            }
+            if (next == NoIndex) {
+                return face;
+            }
+            previous = face;
+            face = next;
+        }
+        return locateByScan(point);
+    }
+
+    std::uint32_t locateByScan(const Point2D<Scalar>& point) const {
+        std::uint32_t candidate = NoIndex;
+        for (std::uint32_t index = 0; index < m_faces.size(); ++index) {
+            const Face& face = m_faces[index];
+            if (!face.alive) {
+                continue;
+            }
+            if (ghostCorner(face) >= 0) {
+                if (candidate == NoIndex && inConflict(index, point, PredicateKernel::Filtered)) {
+                    candidate = index;
+                }
+                continue;
+            }
+            if (orientation(face.vertices[0], face.vertices[1], point) >= 0 &&
+                orientation(face.vertices[1], face.vertices[2], point) >= 0 &&
+                orientation(face.vertices[2], face.vertices[0], point) >= 0) {
+                return index;
+            }
+        }
+        return candidate;
+    }
+
+    std::uint32_t nextStamp(std::vector<std::uint32_t>& marks, std::uint32_t& stamp) {
+        if (stamp >= NoIndex - 2) {
+            std::fill(marks.begin(), marks.end(), 0u);
+            stamp = 0;
+        }
+        stamp += 2;
+        return stamp;
+    }
+
+    // Flood-fills the faces whose circumcircle contains the point, starting from the face that
+    // contains it, and records the cavity boundary. Returns false if the cavity is not a
+    // star-shaped disk around the point.
+    bool collectCavity(std::uint32_t seed, const Point2D<Scalar>& point, PredicateKernel kernel) {
+        m_cavity.clear();
+        m_boundary.clear();
+        if (!inConflict(seed, point, kernel)) {
+            return false;
+        }
+
+        const std::uint32_t inside = nextStamp(m_faceMark, m_faceStamp);
+        const std::uint32_t outside = inside + 1;
+        m_faceMark[seed] = inside;
+        m_cavity.push_back(seed);
+        for (std::size_t i = 0; i < m_cavity.size(); ++i) {
+            const std::uint32_t face = m_cavity[i];
+            for (int edge = 0; edge < 3; ++edge) {
+                const std::uint32_t neighbor = m_faces[face].neighbors[edge];
+                if (m_faceMark[neighbor] == inside) {
+                    continue;
+                }
+                if (m_faceMark[neighbor] != outside && inConflict(neighbor, point, kernel)) {
+                    m_faceMark[neighbor] = inside;
+                    m_cavity.push_back(neighbor);
+                    continue;
+                }
+                m_faceMark[neighbor] = outside;
+                m_boundary.push_back({m_faces[face].vertices[(edge + 1) % 3],
+                                      m_faces[face].vertices[(edge + 2) % 3],
+                                      neighbor});
+            }
+        }
+
+        if (kernel == PredicateKernel::Filtered) {
+            return true;
+        }
+        if (m_boundary.size() != m_cavity.size() + 2) {
+            return false;
+        }
+        for (const auto& edge : m_boundary) {
+            if (edge.u != GhostVertex && edge.w != GhostVertex && orientation(edge.u, edge.w, point) <= 0) {
+                return false;
+            }
+        }
+
+        const std::uint32_t seen = nextStamp(m_vertexMark, m_vertexStamp);
+        std::size_t interior = 0;
+        for (const auto face : m_cavity) {
+            for (const auto corner : m_faces[face].vertices) {
+                if (corner != GhostVertex && m_vertexMark[corner] != seen) {
+                    m_vertexMark[corner] = seen;
+                    ++interior;
+                }
+            }
+        }
+        for (const auto& edge : m_boundary) {
+            if (edge.u == GhostVertex) {
+                continue;
+            }
+            if (m_vertexMark[edge.u] != seen) {
+                return false;
+            }
+            m_vertexMark[edge.u] = seen + 1;
+            --interior;
+        }
+        return interior == 0;
+    }
+
+    void fillCavity(std::uint32_t vertex) {
+        for (const auto face : m_cavity) {
+            releaseFace(face);
+        }
+
+        m_fan.clear();
+        for (const auto& edge : m_boundary) {
+            const std::uint32_t created = allocateFace({edge.u, edge.w, vertex});
+            m_faces[created].neighbors[2] = edge.outside;
+            replaceNeighbor(edge.outside, edge.w, edge.u, created);
+            m_fan.emplace_back(edge.u, created);
+        }
+
+        std::sort(m_fan.begin(), m_fan.end());
+        for (const auto& [first, face] : m_fan) {
+            const std::uint32_t last = m_faces[face].vertices[1];
+            const auto next = std::lower_bound(m_fan.begin(), m_fan.end(),
+                                               std::make_pair(last, std::uint32_t{0}));
+            m_faces[face].neighbors[0] = next->second;
+            m_faces[next->second].neighbors[1] = face;
+        }
+    }
+
+    static bool isConstrained(const Face& face, int corner) {
+        return (face.constrained & (1u << corner)) != 0;
+    }
+
+    // Flags the edge opposite the corner on both faces that share it.
+    void setConstrained(std::uint32_t faceIndex, int corner) {
+        Face& face = m_faces[faceIndex];
+        face.constrained = static_cast<std::uint8_t>(face.constrained | (1u << corner));
+        Face& other = m_faces[face.neighbors[corner]];
+        for (int i = 0; i < 3; ++i) {
+            if (other.neighbors[i] == faceIndex) {
+                other.constrained = static_cast<std::uint8_t>(other.constrained | (1u << i));
+            }
+        }
+    }
+
+    // Inserts the part of the constraint up to the first vertex met on it and returns that vertex.
+    std::uint32_t insertConstraintPiece(std::uint32_t from, std::uint32_t to) {
+        const auto& target = m_points[to];
+
+        // Find the face of the star of `from` whose wedge contains the segment.
+        const std::uint32_t first = m_vertexFace[from];
+        std::uint32_t face = first;
+        std::uint32_t right = NoIndex;
+        std::uint32_t left = NoIndex;
+        do {
+            const Face& current = m_faces[face];
+            const int corner = cornerOf(current, from);
+            if (ghostCorner(current) < 0) {
+                for (int step = 1; step <= 2; ++step) {
+                    const std::uint32_t vertex = current.vertices[(corner + step) % 3];
+                    if (orientation(from, to, m_points[vertex]) == 0 &&
+                        collinearPosition(m_points[from], target, m_points[vertex]) == 0) {
+                        setConstrained(face, (corner + 3 - step) % 3);
+                        return vertex;
+                    }
+                }
+                const std::uint32_t p = current.vertices[(corner + 1) % 3];
+                const std::uint32_t q = current.vertices[(corner + 2) % 3];
+                if (orientation(from, to, m_points[p]) < 0 && orientation(from, to, m_points[q]) > 0) {
+                    right = p;
+                    left = q;
+                    break;
+                }
+            }
+            face = current.neighbors[(corner + 1) % 3];
+        } while (face != first);
+        if (right == NoIndex) {
+            throw std::logic_error("Triangulation: constraint leaves the triangulation");
+        }
+
+        // Walk along the segment collecting the crossed faces and the vertices on either side.
+        std::vector<std::uint32_t> crossed{face};
+        std::vector<std::uint32_t> leftChain{left};
+        std::vector<std::uint32_t> rightChain{right};
+        std::uint32_t reached = NoIndex;
+        while (reached == NoIndex) {
+            const Face& current = m_faces[face];
+            int corner = 0;
+            while (current.vertices[corner] == right || current.vertices[corner] == left) {
+                ++corner;
+            }
+            if (isConstrained(current, corner)) {
+                throw std::invalid_argument("constrainedDelaunayTriangulation: constraints intersect");
+            }
+            face = current.neighbors[corner];
+            const Face& next = m_faces[face];
+            if (ghostCorner(next) >= 0) {
+                throw std::logic_error("Triangulation: constraint leaves the triangulation");
+            }
+            crossed.push_back(face);
+
+            int apexCorner = 0;
+            while (next.vertices[apexCorner] == right || next.vertices[apexCorner] == left) {
+                ++apexCorner;
+            }
+            const std::uint32_t apex = next.vertices[apexCorner];
+            const int side = apex == to ? 0 : orientation(from, to, m_points[apex]);
+            if (side == 0) {
+                reached = apex;
+            } else if (side > 0) {
+                leftChain.push_back(apex);
+                left = apex;
+            } else {
+                rightChain.push_back(apex);
+                right = apex;
+            }
+        }
+
+        // Record the outline of the crossed region, then replace its faces.
+        const std::uint32_t inside = nextStamp(m_faceMark, m_faceStamp);
+        for (const auto index : crossed) {
+            m_faceMark[index] = inside;
+        }
+        struct OutlineEdge {
+            std::uint32_t u;
+            std::uint32_t w;
+            std::uint32_t face;
+            int corner;
+            bool constrained;
+        };
+        std::vector<OutlineEdge> outline;
+        for (const auto index : crossed) {
+            const Face& current = m_faces[index];
+            for (int corner = 0; corner < 3; ++corner) {
+                if (m_faceMark[current.neighbors[corner]] != inside) {
+                    outline.push_back({current.vertices[(corner + 1) % 3], current.vertices[(corner + 2) % 3],
+                                       current.neighbors[corner], corner, isConstrained(current, corner)});
+                }
+            }
+        }
+        for (const auto index : crossed) {
+            releaseFace(index);
+        }
+
+        std::vector<std::uint32_t> created;
+        triangulatePseudoPolygon(from, reached, leftChain, created);
+        std::reverse(rightChain.begin(), rightChain.end());
+        triangulatePseudoPolygon(reached, from, rightChain, created);
+
+        std::vector<OutlineEdge> edges;
+        edges.reserve(3 * created.size());
+        for (const auto index : created) {
+            for (int corner = 0; corner < 3; ++corner) {
+                edges.push_back({m_faces[index].vertices[(corner + 1) % 3], m_faces[index].vertices[(corner + 2) % 3],
+                                 index, corner, false});
+            }
+        }
+        const auto byEdge = [](const OutlineEdge& lhs, const OutlineEdge& rhs) {
+            return lhs.u != rhs.u ? lhs.u < rhs.u : lhs.w < rhs.w;
+        };
+        std::sort(edges.begin(), edges.end(), byEdge);
+        std::sort(outline.begin(), outline.end(), byEdge);
+
+        for (const auto& edge : edges) {
+            Face& current = m_faces[edge.face];
+            const OutlineEdge twin{edge.w, edge.u, 0, 0, false};
+            const auto inner = std::lower_bound(edges.begin(), edges.end(), twin, byEdge);
+            if (inner != edges.end() && inner->u == edge.w && inner->w == edge.u) {
+                current.neighbors[edge.corner] = inner->face;
+                const bool onSegment = (edge.u == from && edge.w == reached) || (edge.u == reached && edge.w == from);
+                if (onSegment) {
+                    current.constrained = static_cast<std::uint8_t>(current.constrained | (1u << edge.corner));
+                }
+                continue;
+            }
+            const OutlineEdge key{edge.u, edge.w, 0, 0, false};
+            const auto outer = std::lower_bound(outline.begin(), outline.end(), key, byEdge);
+            current.neighbors[edge.corner] = outer->face;
+            if (outer->constrained) {
+                current.constrained = static_cast<std::uint8_t>(current.constrained | (1u << edge.corner));
+            }
+            replaceNeighbor(outer->face, edge.w, edge.u, edge.face);
+        }
+        return reached;
+    }
+
+    // Triangulates the region between the directed base edge (from, to) and the chain of
+    // vertices left of it, ordered from `from` to `to`, choosing for every base the chain
+    // vertex whose circumcircle holds no other chain vertex.
+    void triangulatePseudoPolygon(std::uint32_t from, std::uint32_t to,
+                                  const std::vector<std::uint32_t>& chain,
+                                  std::vector<std::uint32_t>& created) {
+        struct Range {
+            std::uint32_t from;
+            std::uint32_t to;
+            std::size_t begin;
+            std::size_t end;
+        };
+        std::vector<Range> pending{{from, to, 0, chain.size()}};
+        while (!pending.empty()) {
+            const Range range = pending.back();
+            pending.pop_back();
+            if (range.begin == range.end) {
+                continue;
+            }
+            std::size_t apex = range.begin;
+            for (std::size_t i = range.begin + 1; i < range.end; ++i) {
+                if (filteredIncircleSign(m_points[range.from], m_points[range.to],
+                                         m_points[chain[apex]], m_points[chain[i]]) > 0) {
+                    apex = i;
+                }
+            }
+            created.push_back(allocateFace({range.from, range.to, chain[apex]}));
+            pending.push_back({range.from, chain[apex], range.begin, apex});
+            pending.push_back({chain[apex], range.to, apex + 1, range.end});
+        }
+    }
+
+    // Walks the faces around the vertex counterclockwise. ring holds the link vertices in CCW
+    // order and outer[i] is the face beyond the link edge (ring[i], ring[i + 1]).
+    void collectStar(std::uint32_t vertex,
+                     std::vector<std::uint32_t>& ring,
+                     std::vector<std::uint32_t>& outer,
+                     std::vector<std::uint32_t>& star) const {
+        const std::uint32_t first = m_vertexFace[vertex];
+        std::uint32_t face = first;
+        do {
+            const Face& current = m_faces[face];
+            const int corner = cornerOf(current, vertex);
+            ring.push_back(current.vertices[(corner + 1) % 3]);
+            outer.push_back(current.neighbors[corner]);
+            star.push_back(face);
+            face = current.neighbors[(corner + 1) % 3];
+        } while (face != first);
+    }
+
+    // Whether the triangle (a, b, c) of the hole may be cut off: a finite triangle must be CCW
+    // with no other link vertex inside its circumcircle, a ghost triangle must have every other
+    // link vertex strictly behind its hull edge.
+    bool isDelaunayEar(const std::vector<std::uint32_t>& ring, std::size_t first) const {
+        std::array<std::uint32_t, 3> corners{ring[first], ring[(first + 1) % ring.size()],
+                                             ring[(first + 2) % ring.size()]};
+        const auto ghost = std::find(corners.begin(), corners.end(), GhostVertex);
+        if (ghost == corners.end()) {
+            if (orientation(corners[0], corners[1], m_points[corners[2]]) <= 0) {
+                return false;
+            }
+        } else {
+            std::rotate(corners.begin(), ghost + 1, corners.end());
+        }
+
+        for (const auto other : ring) {
+            if (other == GhostVertex || other == corners[0] || other == corners[1] || other == corners[2]) {
+                continue;
+            }
+            const auto& point = m_points[other];
+            if (corners[2] == GhostVertex) {
+                if (inGhostConflict(corners[0], corners[1], point)) {
+                    return false;
+                }
+            } else if (filteredIncircleSign(m_points[corners[0]], m_points[corners[1]], m_points[corners[2]], point) > 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Fills the star-shaped hole left by a removed vertex by repeatedly cutting off Delaunay ears.
+    bool retriangulateHole(std::vector<std::uint32_t>& ring, std::vector<std::uint32_t>& outer) {
+        while (ring.size() > 3) {
+            std::size_t ear = ring.size();
+            for (std::size_t i = 0; i < ring.size(); ++i) {
+                if (isDelaunayEar(ring, i)) {
+                    ear = i;
+                    break;
+                }
+            }
+            if (ear == ring.size()) {
+                return false;
+            }
+
+            const std::size_t middle = (ear + 1) % ring.size();
+            const std::size_t last = (ear + 2) % ring.size();
+            const std::uint32_t created = allocateFace({ring[ear], ring[middle], ring[last]});
+            m_faces[created].neighbors[0] = outer[middle];
+            m_faces[created].neighbors[2] = outer[ear];
+            replaceNeighbor(outer[middle], ring[last], ring[middle], created);
+            replaceNeighbor(outer[ear], ring[middle], ring[ear], created);
+            outer[ear] = created;
+            ring.erase(ring.begin() + static_cast<std::ptrdiff_t>(middle));
+            outer.erase(outer.begin() + static_cast<std::ptrdiff_t>(middle));
+        }
+
+        const std::uint32_t created = allocateFace({ring[0], ring[1], ring[2]});
+        m_faces[created].neighbors = {outer[1], outer[2], outer[0]};
+        replaceNeighbor(outer[0], ring[1], ring[0], created);
+        replaceNeighbor(outer[1], ring[2], ring[1], created);
+        replaceNeighbor(outer[2], ring[0], ring[2], created);
+        return true;
+    }
+
+    // An interior vertex can move in place while every face of its star stays CCW.
+    bool starStaysValid(std::uint32_t vertex, const Point2D<Scalar>& point) const {
+        const std::uint32_t first = m_vertexFace[vertex];
+        std::uint32_t face = first;
+        do {
+            const Face& current = m_faces[face];
+            if (ghostCorner(current) >= 0) {
+                return false;
+            }
+            const int corner = cornerOf(current, vertex);
+            if (filteredOrientationSign(point,
+                                        m_points[current.vertices[(corner + 1) % 3]],
+                                        m_points[current.vertices[(corner + 2) % 3]]) <= 0) {
+                return false;
+            }
+            face = current.neighbors[(corner + 1) % 3];
+        } while (face != first);
+        return true;
+    }
+
+    // Replaces the edge opposite vertices[corner] of the face with the other diagonal of the
+    // quadrilateral it forms with its neighbor.
+    void flip(std::uint32_t faceIndex, int corner) {
+        const std::uint32_t otherIndex = m_faces[faceIndex].neighbors[corner];
+        const Face face = m_faces[faceIndex];
+        const Face other = m_faces[otherIndex];
+        int otherCorner = 0;
+        while (other.neighbors[otherCorner] != faceIndex) {
+            ++otherCorner;
+        }
+
+        const std::uint32_t a = face.vertices[corner];
+        const std::uint32_t b = face.vertices[(corner + 1) % 3];
+        const std::uint32_t c = face.vertices[(corner + 2) % 3];
+        const std::uint32_t d = other.vertices[otherCorner];
+        const std::uint32_t acrossCA = face.neighbors[(corner + 1) % 3];
+        const std::uint32_t acrossAB = face.neighbors[(corner + 2) % 3];
+        const std::uint32_t acrossBD = other.neighbors[(otherCorner + 1) % 3];
+        const std::uint32_t acrossDC = other.neighbors[(otherCorner + 2) % 3];
+
+        m_faces[faceIndex].vertices = {a, b, d};
+        m_faces[faceIndex].neighbors = {acrossBD, otherIndex, acrossAB};
+        m_faces[otherIndex].vertices = {a, d, c};
+        m_faces[otherIndex].neighbors = {acrossDC, acrossCA, faceIndex};
+        replaceNeighbor(acrossBD, d, b, faceIndex);
+        replaceNeighbor(acrossCA, a, c, otherIndex);
+        m_vertexFace[a] = faceIndex;
+        m_vertexFace[b] = faceIndex;
+        m_vertexFace[d] = faceIndex;
+        m_vertexFace[c] = otherIndex;
+    }
+
+    // Lawson flips from the given faces until every edge is locally Delaunay again.
+    void restoreDelaunay(std::vector<std::uint32_t> pending) {
+        while (!pending.empty()) {
+            const std::uint32_t faceIndex = pending.back();
+            pending.pop_back();
+            const Face& face = m_faces[faceIndex];
+            if (!face.alive || ghostCorner(face) >= 0) {
+                continue;
+            }
+            for (int corner = 0; corner < 3; ++corner) {
+                const Face& other = m_faces[face.neighbors[corner]];
+                if (ghostCorner(other) >= 0) {
+                    continue;
+                }
+                int otherCorner = 0;
+                while (other.neighbors[otherCorner] != faceIndex) {
+                    ++otherCorner;
+                }
+                if (filteredIncircleSign(m_points[face.vertices[0]], m_points[face.vertices[1]],
+                                         m_points[face.vertices[2]], m_points[other.vertices[otherCorner]]) > 0) {
+                    const std::uint32_t otherIndex = face.neighbors[corner];
+                    flip(faceIndex, corner);
+                    pending.push_back(faceIndex);
+                    pending.push_back(otherIndex);
+                    break;
+                }
+            }
+        }
+    }
+
+    std::vector<Point2D<Scalar>> m_points;
+    std::vector<std::array<double, 2>> m_approx;
+    PredicateKernel m_kernel;
+    std::vector<Face> m_faces;
+    std::vector<std::uint32_t> m_freeFaces;
+    std::vector<std::uint32_t> m_vertexFace;
+    std::vector<std::uint32_t> m_inserted;
+    std::vector<std::uint32_t> m_faceMark;
+    std::vector<std::uint32_t> m_vertexMark;
+    std::vector<std::uint32_t> m_insertedIndex;
+    std::vector<unsigned char> m_live;
+    std::vector<std::uint32_t> m_freeVertices;
+    std::vector<std::uint32_t> m_pending;
+    std::uint32_t m_faceStamp{0};
+    std::uint32_t m_vertexStamp{0};
+    std::size_t m_solidFaces{0};
+    std::vector<std::uint32_t> m_cavity;
+    std::vector<CavityEdge> m_boundary;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> m_fan;
+    std::mt19937 m_generator;
+    std::uint32_t m_walkState{0x9E3779B9u};
+    bool m_spatiallyOrdered{false};
+    bool m_started{false};
+};
+
+inline std::uint32_t hilbertIndex(std::uint32_t x, std::uint32_t y) {
+    constexpr std::uint32_t Side = 1u << 16;
+    std::uint32_t index = 0;
+    for (std::uint32_t s = Side / 2; s > 0; s /= 2) {
+        const std::uint32_t rx = (x & s) != 0 ? 1u : 0u;
+        const std::uint32_t ry = (y & s) != 0 ? 1u : 0u;
+        index += s * s * ((3u * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = Side - 1 - x;
+                y = Side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+// Hilbert curve index of each point on a 2^16 grid over the bounding square; non-finite
+// points sit at the origin of the curve.
+inline std::vector<std::uint32_t> hilbertKeys(const std::vector<std::array<double, 2>>& points) {
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+    for (const auto& point : points) {
+        if (std::isfinite(point[0]) && std::isfinite(point[1])) {
+            minX = std::min(minX, point[0]);
+            maxX = std::max(maxX, point[0]);
+            minY = std::min(minY, point[1]);
+            maxY = std::max(maxY, point[1]);
+        }
+    }
+    const double extent = std::max(maxX - minX, maxY - minY);
+    const double scale = extent > 0.0 && std::isfinite(extent) ? 65535.0 / extent : 0.0;
+    const auto quantize = [&](double value, double origin) {
+        const double cell = (value - origin) * scale;
+        return cell > 0.0 ? static_cast<std::uint32_t>(std::min(cell, 65535.0)) : 0u;
+    };
+
+    std::vector<std::uint32_t> keys(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        keys[i] = hilbertIndex(quantize(points[i][0], minX), quantize(points[i][1], minY));
+    }
+    return keys;
+}
+
+// Biased randomized insertion order: the shuffled points are split into rounds of doubling size
+// and each round is sorted along a Hilbert curve, so walks stay short and cache-local.
+inline std::vector<std::uint32_t> brioOrder(const std::vector<std::array<double, 2>>& points,
+                                            std::mt19937& generator) {
+    const std::vector<std::uint32_t> keys = hilbertKeys(points);
+    std::vector<std::uint32_t> order(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        order[i] = static_cast<std::uint32_t>(i);
+    }
+    std::shuffle(order.begin(), order.end(), generator);
+
+    constexpr std::size_t MinRound = 64;
+    std::size_t end = order.size();
+    while (end > 0) {
+        const std::size_t begin = end > MinRound ? end / 2 : 0;
+        std::sort(order.begin() + static_cast<std::ptrdiff_t>(begin),
+                  order.begin() + static_cast<std::ptrdiff_t>(end),
+                  [&](std::uint32_t lhs, std::uint32_t rhs) {
+                      return keys[lhs] != keys[rhs] ? keys[lhs] < keys[rhs] : lhs < rhs;
+                  });
+        end = begin;
+    }
+    return order;
+}
+
+// Inserts every point in BRIO order, then the constraints; duplicate points are mapped onto the
+// vertex already at their position. Returns false when the points are collinear.
+template <typename Scalar>
+bool buildConstrainedTriangulation(Triangulation<Scalar>& triangulation,
+                                   const std::vector<std::array<std::uint32_t, 2>>& constraints) {
+    std::mt19937 generator{DefaultTriangulationSeed};
+    triangulation.insertAll(brioOrder(triangulation.approximatePoints(), generator));
+    if (!triangulation.started()) {
+        return false;
+    }
+
+    const auto& points = triangulation.points();
+    std::vector<std::uint32_t> representative(points.size(), NoIndex);
+    for (std::uint32_t i = 0; i < points.size(); ++i) {
+        representative[i] = triangulation.isInserted(i) ? i : triangulation.findVertex(points[i]);
+    }
+    for (const auto& constraint : constraints) {
+        const std::uint32_t from = representative[constraint[0]];
+        const std::uint32_t to = representative[constraint[1]];
+        if (from != NoIndex && to != NoIndex) {
+            triangulation.insertConstraint(from, to);
+        }
+    }
+    return true;
+}
+
+// Guibas-Stolfi divide and conquer over lexicographically sorted, distinct points, stored as a
+// quad-edge structure in flat arrays. A subproblem over points [lo, hi) owns quad-edge slots
+// [3 lo, 3 hi), which bounds every planar graph on its points, so subproblems run concurrently
+// without sharing an allocator.
+template <typename Scalar>
+class DivideAndConquerDelaunay {
+public:
+    explicit DivideAndConquerDelaunay(const std::vector<Point2D<Scalar>>& points)
+        : m_points(points),
+          m_next(12 * points.size()),
+          m_origin(6 * points.size()),
+          m_alive(3 * points.size(), 0) {}
+
+    void build(unsigned threadCount) {
+        const auto count = static_cast<std::uint32_t>(m_points.size());
+        if (count < 2) {
+            return;
+        }
+        unsigned depth = 0;
+        while ((1u << depth) < threadCount && depth < 16) {
+            ++depth;
+        }
+        EdgePool pool{0, 3 * count, {}};
+        divide(0, count, pool, depth);
+    }
+
+    // Vertex indices refer to the sorted point array the triangulation was built on.
+    void exportTopology(TriangleMesh<Scalar>& mesh) const {
+        std::vector<std::uint32_t> faceOf(m_next.size(), NoIndex);
+        std::vector<std::array<std::uint32_t, 3>> faceEdges;
+        faceEdges.reserve(2 * m_points.size());
+        mesh.triangles.clear();
+        mesh.triangles.reserve(2 * m_points.size());
+        for (std::uint32_t quad = 0; quad < m_alive.size(); ++quad) {
+            if (!m_alive[quad]) {
+                continue;
+            }
+            for (const std::uint32_t edge : {4 * quad, 4 * quad + 2}) {
+                const std::uint32_t second = lnext(edge);
+                const std::uint32_t third = lnext(second);
+                if (lnext(third) != edge || second < edge || third < edge ||
+                    !ccw(org(edge), org(second), org(third))) {
+                    continue;
+                }
+                const auto face = static_cast<std::uint32_t>(faceEdges.size());
+                faceOf[edge] = face;
+                faceOf[second] = face;
+                faceOf[third] = face;
+                faceEdges.push_back({edge, second, third});
+                mesh.triangles.push_back({org(edge), org(second), org(third)});
+            }
+        }
+
+        mesh.neighbors.clear();
+        mesh.neighbors.reserve(faceEdges.size());
+        for (const auto& edges : faceEdges) {
+            mesh.neighbors.push_back({faceOf[sym(edges[1])], faceOf[sym(edges[2])], faceOf[sym(edges[0])]});
+        }
+    }
+
+private:
+    struct EdgePool {
+        std::uint32_t cursor;
+        std::uint32_t end;
+        std::vector<std::uint32_t> free;
+    };
+
+    // Counterclockwise convex hull edge out of the leftmost vertex and clockwise edge out of
+    // the rightmost vertex.
+    struct Hull {
+        std::uint32_t left;
+        std::uint32_t right;
+    };
+
+    static std::uint32_t rot(std::uint32_t edge) {
+        return (edge & ~3u) | ((edge + 1) & 3u);
+    }
+
+    static std::uint32_t sym(std::uint32_t edge) {
+        return edge ^ 2u;
+    }
+
+    static std::uint32_t invRot(std::uint32_t edge) {
+        return (edge & ~3u) | ((edge + 3) & 3u);
+    }
+
+    std::uint32_t onext(std::uint32_t edge) const {
+        return m_next[edge];
+    }
+
+    std::uint32_t oprev(std::uint32_t edge) const {
+        return rot(onext(rot(edge)));
+    }
+
+    std::uint32_t lnext(std::uint32_t edge) const {
+        return rot(onext(invRot(edge)));
+    }
+
+    std::uint32_t rprev(std::uint32_t edge) const {
+        return onext(sym(edge));
+    }
+
+    std::uint32_t org(std::uint32_t edge) const {
+        return m_origin[edge >> 1];
+    }
+
+    std::uint32_t dest(std::uint32_t edge) const {
+        return org(sym(edge));
+    }
+
+    bool ccw(std::uint32_t a, std::uint32_t b, std::uint32_t c) const {
+        return filteredOrientationSign(m_points[a], m_points[b], m_points[c]) > 0;
+    }
+
+    bool rightOf(std::uint32_t vertex, std::uint32_t edge) const {
+        return ccw(vertex, dest(edge), org(edge));
+    }
+
+    bool leftOf(std::uint32_t vertex, std::uint32_t edge) const {
+        return ccw(vertex, org(edge), dest(edge));
+    }
+
+    bool inCircle(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) const {
+        return filteredIncircleSign(m_points[a], m_points[b], m_points[c], m_points[d]) > 0;
+    }
+
+    std::uint32_t makeEdge(std::uint32_t from, std::uint32_t to, EdgePool& pool) {
+        std::uint32_t quad = 0;
+        if (!pool.free.empty()) {
+            quad = pool.free.back();
+            pool.free.pop_back();
+        } else {
+            if (pool.cursor == pool.end) {
+                throw std::logic_error("DivideAndConquerDelaunay: edge pool exhausted");
+            }
+            quad = pool.cursor++;
+        }
+        const std::uint32_t edge = 4 * quad;
+        m_next[edge] = edge;
+        m_next[edge + 1] = edge + 3;
+        m_next[edge + 2] = edge + 2;
+        m_next[edge + 3] = edge + 1;
+        m_origin[edge >> 1] = from;
+        m_origin[(edge >> 1) + 1] = to;
+        m_alive[quad] = 1;
+        return edge;
+    }
+
+    void splice(std::uint32_t a, std::uint32_t b) {
+        const std::uint32_t alpha = rot(onext(a));
+        const std::uint32_t beta = rot(onext(b));
+        std::swap(m_next[a], m_next[b]);
+        std::swap(m_next[alpha], m_next[beta]);
+    }
+
+    std::uint32_t connect(std::uint32_t a, std::uint32_t b, EdgePool& pool) {
+        const std::uint32_t edge = makeEdge(dest(a), org(b), pool);
+        splice(edge, lnext(a));
+        splice(sym(edge), b);
+        return edge;
+    }
+
+    void deleteEdge(std::uint32_t edge, EdgePool& pool) {
+        splice(edge, oprev(edge));
+        splice(sym(edge), oprev(sym(edge)));
+        m_alive[edge >> 2] = 0;
+        pool.free.push_back(edge >> 2);
+    }
+
+    Hull divide(std::uint32_t lo, std::uint32_t hi, EdgePool& pool, unsigned parallelDepth) {
+        const std::uint32_t count = hi - lo;
+        if (count == 2) {
+            const std::uint32_t a = makeEdge(lo, lo + 1, pool);
+            return {a, sym(a)};
+        }
+        if (count == 3) {
+            const std::uint32_t a = makeEdge(lo, lo + 1, pool);
+            const std::uint32_t b = makeEdge(lo + 1, lo + 2, pool);
+            splice(sym(a), b);
+            if (ccw(lo, lo + 1, lo + 2)) {
+                connect(b, a, pool);
+                return {a, sym(b)};
+            }
+            if (ccw(lo, lo + 2, lo + 1)) {
+                const std::uint32_t c = connect(b, a, pool);
+                return {sym(c), c};
+            }
+            return {a, sym(b)};
+        }
+
+        constexpr std::uint32_t MinParallelCount = 1u << 14;
+        const std::uint32_t mid = lo + count / 2;
+        Hull left{};
+        Hull right{};
+        if (parallelDepth > 0 && count >= MinParallelCount) {
+            EdgePool leftPool{3 * lo, 3 * mid, {}};
+            EdgePool rightPool{3 * mid, 3 * hi, {}};
+            auto pending = std::async(std::launch::async, [&] {
+                return divide(lo, mid, leftPool, parallelDepth - 1);
+            });
+            right = divide(mid, hi, rightPool, parallelDepth - 1);
+            left = pending.get();
+
+            pool.cursor = rightPool.cursor;
+            pool.end = rightPool.end;
+            pool.free = std::move(leftPool.free);
+            pool.free.insert(pool.free.end(), rightPool.free.begin(), rightPool.free.end());
+            for (std::uint32_t quad = leftPool.cursor; quad < leftPool.end; ++quad) {
+                pool.free.push_back(quad);
+            }
+        } else {
+            left = divide(lo, mid, pool, 0);
+            right = divide(mid, hi, pool, 0);
+        }
+        return merge(left, right, pool);
+    }
+
+    Hull merge(Hull left, Hull right, EdgePool& pool) {
+        std::uint32_t ldo = left.left;
+        std::uint32_t ldi = left.right;
+        std::uint32_t rdi = right.left;
+        std::uint32_t rdo = right.right;
+
+        while (true) {
+            if (leftOf(org(rdi), ldi)) {
+                ldi = lnext(ldi);
+            } else if (rightOf(org(ldi), rdi)) {
+                rdi = rprev(rdi);
+            } else {
+                break;
+            }
+        }
+
+        std::uint32_t basel = connect(sym(rdi), ldi, pool);
+        if (org(ldi) == org(ldo)) {
+            ldo = sym(basel);
+        }
+        if (org(rdi) == org(rdo)) {
+            rdo = basel;
+        }
+
+        const auto valid = [&](std::uint32_t edge) {
+            return rightOf(dest(edge), basel);
+        };
+
+        while (true) {
+            std::uint32_t lcand = onext(sym(basel));
+            if (valid(lcand)) {
+                while (inCircle(dest(basel), org(basel), dest(lcand), dest(onext(lcand)))) {
+                    const std::uint32_t next = onext(lcand);
+                    deleteEdge(lcand, pool);
+                    lcand = next;
+                }
+            }
+            std::uint32_t rcand = oprev(basel);
+            if (valid(rcand)) {
+                while (inCircle(dest(basel), org(basel), dest(rcand), dest(oprev(rcand)))) {
+                    const std::uint32_t next = oprev(rcand);
+                    deleteEdge(rcand, pool);
+                    rcand = next;
+                }
+            }
+
+            const bool leftValid = valid(lcand);
+            const bool rightValid = valid(rcand);
+            if (!leftValid && !rightValid) {
+                break;
+            }
+            if (!leftValid || (rightValid && inCircle(dest(lcand), org(lcand), org(rcand), dest(rcand)))) {
+                basel = connect(rcand, sym(basel), pool);
+            } else {
+                basel = connect(sym(basel), sym(lcand), pool);
+            }
+        }
+        return {ldo, rdo};
+    }
+
+    const std::vector<Point2D<Scalar>>& m_points;
+    std::vector<std::uint32_t> m_next;
+    std::vector<std::uint32_t> m_origin;
+    std::vector<unsigned char> m_alive;
+};
+
+// Bentley-Ottmann sweep in lexicographic (x, then y) order. The sweep collects candidate pairs:
+// segments that meet at an event point or intersect while neighbours in the status; the caller
+// decides each pair with intersectSegments. The status is only ordered by exact orientation
+// tests against input endpoints. Crossings swap neighbouring entries in place instead, so a
+// rounded crossing point can delay a swap but never corrupts the order.
+template <typename Scalar>
+class SegmentSweep {
+public:
+    SegmentSweep(const std::vector<Segment2D<Scalar>>& segments, const Scalar& epsilon, PredicateKernel kernel)
+        : m_epsilon(epsilon),
+          m_kernel(kernel),
+          m_status(StatusLess{this}),
+          m_handles(segments.size()),
+          m_inStatus(segments.size(), 0),
+          m_stamp(segments.size(), 0) {
+        m_segments.reserve(segments.size());
+        for (std::uint32_t index = 0; index < segments.size(); ++index) {
+            Segment2D<Scalar> segment = segments[index];
+            if (lexLessExact(segment.end, segment.start)) {
+                std::swap(segment.start, segment.end);
+            }
+            m_segments.push_back(segment);
+            m_events[segment.start].starts.push_back(index);
+            m_events[segment.end].ends.push_back(index);
+        }
+    }
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> run() {
+        while (!m_events.empty()) {
+            const auto node = m_events.begin();
+            m_point = node->first;
+            const Event event = std::move(node->second);
+            m_events.erase(node);
+            handle(event);
+        }
+        std::sort(m_candidates.begin(), m_candidates.end());
+        m_candidates.erase(std::unique(m_candidates.begin(), m_candidates.end()), m_candidates.end());
+        return std::move(m_candidates);
+    }
+
+private:
+    // Stand-ins for the event point in status searches: LowerProbe sorts below every segment
+    // through the point, UpperProbe above them.
+    static constexpr std::uint32_t LowerProbe = NoIndex - 1;
+    static constexpr std::uint32_t UpperProbe = NoIndex;
+
+    struct Event {
+        std::vector<std::uint32_t> starts;
+        std::vector<std::uint32_t> ends;
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> crossings;
+    };
+
+    struct PointLess {
+        bool operator()(const Point2D<Scalar>& lhs, const Point2D<Scalar>& rhs) const {
+            return lexLessExact(lhs, rhs);
+        }
+    };
+
+    // The segment is mutable so that a crossing swaps two neighbouring entries in place.
+    struct Entry {
+        mutable std::uint32_t segment;
+    };
+
+    struct StatusLess {
+        const SegmentSweep* sweep;
+
+        bool operator()(const Entry& lhs, const Entry& rhs) const {
+            return sweep->below(lhs.segment, rhs.segment);
+        }
+    };
+
+    using Status = std::set<Entry, StatusLess>;
+
+    // +1 when the event point lies above the segment, -1 below, 0 on it. Segments starting or
+    // ending at the event point count as on it.
+    int side(std::uint32_t segment) const {
+        if (m_stamp[segment] == m_eventStamp) {
+            return 0;
+        }
+        return filteredOrientationSign(m_segments[segment].start, m_segments[segment].end, m_point);
+    }
+
+    bool below(std::uint32_t lhs, std::uint32_t rhs) const {
+        if (lhs == rhs) {
+            return false;
+        }
+        if (lhs == LowerProbe || lhs == UpperProbe) {
+            const int rhsSide = side(rhs);
+            return lhs == LowerProbe ? rhsSide <= 0 : rhsSide < 0;
+        }
+        if (rhs == LowerProbe || rhs == UpperProbe) {
+            const int lhsSide = side(lhs);
+            return rhs == LowerProbe ? lhsSide > 0 : lhsSide >= 0;
+        }
+        const int lhsSide = side(lhs);
+        const int rhsSide = side(rhs);
+        if (lhsSide != rhsSide) {
+            return lhsSide > rhsSide;
+        }
+        if (lhsSide == 0) {
+            // Both pass through the event point: order by direction just after it.
+            const auto& first = m_segments[lhs];
+            const auto& second = m_segments[rhs];
+            const int lhsEnd = filteredOrientationSign(second.start, second.end, first.end);
+            if (lhsEnd != 0) {
+                return lhsEnd < 0;
+            }
+            const int rhsEnd = filteredOrientationSign(first.start, first.end, second.end);
+            if (rhsEnd != 0) {
+                return rhsEnd > 0;
+            }
+        }
+        return lhs < rhs;
+    }
+
+    // lower lies directly below upper; true when their right ends are the other way round, so
+    // the two cross before either ends.
+    bool mustCross(std::uint32_t lower, std::uint32_t upper) const {
+        const auto& first = m_segments[lower];
+        const auto& second = m_segments[upper];
+        return filteredOrientationSign(second.start, second.end, first.end) > 0 &&
+               filteredOrientationSign(first.start, first.end, second.end) < 0;
+    }
+
+    void handle(const Event& event) {
+        ++m_eventStamp;
+        m_late.clear();
+        m_deferred.clear();
+        for (const auto& crossing : event.crossings) {
+            m_late.push_back(crossing);
+        }
+        m_exactPoint = !event.starts.empty() || !event.ends.empty();
+        if (m_exactPoint) {
+            undoEarlySwaps();
+            collectNearbyCrossings();
+        }
+        swapCrossings(m_exactPoint);
+
+        m_group.clear();
+        for (const auto segment : event.starts) {
+            mark(segment);
+        }
+        for (const auto segment : event.ends) {
+            mark(segment);
+        }
+        // Every status entry through the event point, including the ending ones, is contiguous.
+        m_through.clear();
+        const auto blockBegin = m_status.lower_bound(Entry{LowerProbe});
+        auto blockEnd = blockBegin;
+        for (; blockEnd != m_status.end() && side(blockEnd->segment) == 0; ++blockEnd) {
+            if (m_stamp[blockEnd->segment] != m_eventStamp) {
+                mark(blockEnd->segment);
+                m_through.push_back(blockEnd);
+            }
+        }
+        for (std::size_t i = 0; i < m_group.size(); ++i) {
+            for (std::size_t j = i + 1; j < m_group.size(); ++j) {
+                addCandidate(m_group[i], m_group[j]);
+            }
+        }
+        if (m_kernel == PredicateKernel::Tolerance) {
+            // Segments passing within epsilon of the point meet everything at it.
+            for (auto it = blockBegin; it != m_status.begin();) {
+                if (!nearEventPoint((--it)->segment)) {
+                    break;
+                }
+                addCandidates(it->segment);
+            }
+            for (auto it = blockEnd; it != m_status.end() && nearEventPoint(it->segment); ++it) {
+                addCandidates(it->segment);
+            }
+        }
+
+        for (const auto segment : event.ends) {
+            if (m_inStatus[segment] != 0) {
+                m_status.erase(m_handles[segment]);
+                m_inStatus[segment] = 0;
+            }
+        }
+
+        // Segments passing through the point take their order just after it.
+        m_order.clear();
+        for (const auto it : m_through) {
+            m_order.push_back(it->segment);
+        }
+        std::sort(m_order.begin(), m_order.end(),
+                  [this](std::uint32_t lhs, std::uint32_t rhs) { return below(lhs, rhs); });
+        for (std::size_t index = 0; index < m_through.size(); ++index) {
+            m_through[index]->segment = m_order[index];
+            m_handles[m_order[index]] = m_through[index];
+        }
+
+        // Zero-length segments never enter the status: every segment through them is in the
+        // group above.
+        std::uint32_t lowest = m_order.empty() ? NoIndex : m_order.front();
+        std::uint32_t highest = m_order.empty() ? NoIndex : m_order.back();
+        for (const auto segment : event.starts) {
+            if (pointsIdentical(m_segments[segment].start, m_segments[segment].end)) {
+                continue;
+            }
+            m_handles[segment] = m_status.insert(Entry{segment}).first;
+            m_inStatus[segment] = 1;
+            if (lowest == NoIndex || below(segment, lowest)) {
+                lowest = segment;
+            }
+            if (highest == NoIndex || below(highest, segment)) {
+                highest = segment;
+            }
+        }
+
+        if (lowest == NoIndex) {
+            const auto above = m_status.lower_bound(Entry{UpperProbe});
+            if (above != m_status.begin() && above != m_status.end()) {
+                checkNeighbours(std::prev(above)->segment, above->segment);
+            }
+        } else {
+            const auto first = m_handles[lowest];
+            if (first != m_status.begin()) {
+                checkNeighbours(std::prev(first)->segment, lowest);
+            }
+            const auto last = std::next(m_handles[highest]);
+            if (last != m_status.end()) {
+                checkNeighbours(highest, last->segment);
+            }
+        }
+        swapCrossings(m_exactPoint);
+        m_late.swap(m_deferred);
+        swapCrossings(false);
+    }
+
+    void mark(std::uint32_t segment) {
+        if (m_stamp[segment] != m_eventStamp) {
+            m_stamp[segment] = m_eventStamp;
+            m_group.push_back(segment);
+        }
+    }
+
+    // Swaps the queued pairs that are still neighbours in the wrong order; new neighbours whose
+    // crossing rounds to this event or before it are queued in turn. At an input point the exact
+    // sides of the point decide whether a pair has crossed yet.
+    void swapCrossings(bool exactPoint) {
+        for (std::size_t index = 0; index < m_late.size(); ++index) {
+            const auto [lower, upper] = m_late[index];
+            if (m_inStatus[lower] == 0 || m_inStatus[upper] == 0) {
+                continue;
+            }
+            const auto lowerEntry = m_handles[lower];
+            const auto upperEntry = m_handles[upper];
+            if (std::next(lowerEntry) != upperEntry || !mustCross(lower, upper)) {
+                continue;
+            }
+            if (exactPoint && side(lower) > side(upper)) {
+                // The crossing rounded onto this input point but lies just after it.
+                m_deferred.emplace_back(lower, upper);
+                continue;
+            }
+            swapNeighbours(lower, upper);
+            if (!exactPoint) {
+                m_recent.push_back({m_point, {upper, lower}});
+            }
+        }
+        m_late.clear();
+    }
+
+    void swapNeighbours(std::uint32_t lower, std::uint32_t upper) {
+        const auto lowerEntry = m_handles[lower];
+        const auto upperEntry = m_handles[upper];
+        lowerEntry->segment = upper;
+        upperEntry->segment = lower;
+        m_handles[lower] = upperEntry;
+        m_handles[upper] = lowerEntry;
+        addCandidate(lower, upper);
+        if (lowerEntry != m_status.begin()) {
+            checkNeighbours(std::prev(lowerEntry)->segment, upper);
+        }
+        const auto next = std::next(upperEntry);
+        if (next != m_status.end()) {
+            checkNeighbours(lower, next->segment);
+        }
+    }
+
+    Scalar roundoff() const {
+        return Scalar{64} * std::numeric_limits<Scalar>::epsilon() *
+               (Scalar{1} + absValue(m_point.x) + absValue(m_point.y));
+    }
+
+    // A swap made at a rounded crossing just before this input point may have been early; the
+    // exact sides of the point tell, and such pairs are swapped back, latest first, to cross
+    // after it.
+    void undoEarlySwaps() {
+        const Scalar tolerance = roundoff();
+        while (!m_recent.empty() && m_point.x - m_recent.front().first.x > tolerance) {
+            m_recent.pop_front();
+        }
+        for (auto recent = m_recent.rbegin(); recent != m_recent.rend(); ++recent) {
+            const auto& point = recent->first;
+            const auto [lower, upper] = recent->second;
+            if (absValue(point.y - m_point.y) > tolerance || m_inStatus[lower] == 0 || m_inStatus[upper] == 0 ||
+                std::next(m_handles[lower]) != m_handles[upper]) {
+                continue;
+            }
+            if (side(lower) < side(upper)) {
+                swapNeighbours(lower, upper);
+            }
+        }
+    }
+
+    // A crossing that rounded to just past this input point may already have happened at it;
+    // the exact sides of the point tell.
+    void collectNearbyCrossings() {
+        const Scalar tolerance = roundoff();
+        auto next = m_events.begin();
+        while (next != m_events.end() && next->first.x - m_point.x <= tolerance) {
+            const Scalar x = next->first.x;
+            for (next = m_events.lower_bound({x, m_point.y - tolerance});
+                 next != m_events.end() && next->first.x == x && next->first.y - m_point.y <= tolerance; ++next) {
+                for (const auto& crossing : next->second.crossings) {
+                    if (side(crossing.first) < side(crossing.second)) {
+                        m_late.push_back(crossing);
+                    }
+                }
+            }
+            next = m_events.upper_bound({x, std::numeric_limits<Scalar>::infinity()});
+        }
+    }
+
+    const Point2D<Scalar>& firstEnd(std::uint32_t a, std::uint32_t b) const {
+        return lexLessExact(m_segments[b].end, m_segments[a].end) ? m_segments[b].end : m_segments[a].end;
+    }
+
+    void addCandidate(std::uint32_t a, std::uint32_t b) {
+        m_candidates.emplace_back(std::min(a, b), std::max(a, b));
+    }
+
+    void addCandidates(std::uint32_t segment) {
+        for (const auto other : m_group) {
+            addCandidate(segment, other);
+        }
+    }
+
+    bool nearEventPoint(std::uint32_t segment) const {
+        return pointOnSegment(m_point, m_segments[segment].start, m_segments[segment].end, m_epsilon);
+    }
+
+    // lower lies directly below upper.
+    void checkNeighbours(std::uint32_t lower, std::uint32_t upper) {
+        const auto result = intersectSegments(m_segments[lower], m_segments[upper], m_epsilon, m_kernel);
+        if (result.type != IntersectionType::None) {
+            addCandidate(lower, upper);
+        }
+        if (!mustCross(lower, upper)) {
+            return;
+        }
+        if (m_exactPoint && side(lower) < side(upper)) {
+            // Already the other way round at this input point.
+            m_late.emplace_back(lower, upper);
+            return;
+        }
+        // The swap happens at the rounded crossing, but no later than the first right end, so
+        // that both segments are still in the status.
+        const auto crossing = intersectSegmentsFiltered(m_segments[lower], m_segments[upper]);
+        Point2D<Scalar> at = firstEnd(lower, upper);
+        if (crossing.type == IntersectionType::Point && lexLessExact(crossing.point, at)) {
+            at = crossing.point;
+        }
+        if (lexLessExact(m_point, at)) {
+            m_events[at].crossings.emplace_back(lower, upper);
+        } else {
+            m_late.emplace_back(lower, upper);
+        }
+    }
+
+    Scalar m_epsilon;
+    PredicateKernel m_kernel;
+    std::vector<Segment2D<Scalar>> m_segments;
+    std::map<Point2D<Scalar>, Event, PointLess> m_events;
+    Status m_status;
+    std::vector<typename Status::iterator> m_handles;
+    std::vector<unsigned char> m_inStatus;
+    std::vector<std::uint32_t> m_stamp;
+    std::uint32_t m_eventStamp = 0;
+    Point2D<Scalar> m_point{};
+    bool m_exactPoint = false;
+    std::vector<std::uint32_t> m_group;
+    std::vector<typename Status::iterator> m_through;
+    std::vector<std::uint32_t> m_order;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> m_late;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> m_deferred;
+    std::deque<std::pair<Point2D<Scalar>, std::pair<std::uint32_t, std::uint32_t>>> m_recent;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> m_candidates;
+};
+
+// Under the tolerance kernel two segments can meet without touching. intersectSegments then
+// accepts parameters up to epsilon * (|r| + |s| + 1) past an end, so some endpoint lies within
+// reach = 2 * epsilon * (|own| + longest + 1) * max(|own|, 1) of the other segment, |own| being
+// the longest segment ending there; when both ends overshoot, the endpoint of the longer one has
+// the other's endpoint within its reach. Each distinct endpoint gets the two diagonals of its
+// reach box as probe segments, and a segment entering the box either crosses a diagonal or ends
+// inside it. The exact sweep over segments and probes finds the first kind, and a scan of the
+// endpoints sorted by x finds endpoints inside each other's boxes. Pairs accepted only by the
+// collinear test, whose allowance grows with the squared distance between the segments, are
+// left out: covering them would size every box by longest^2.
+template <typename Scalar>
+std::vector<SegmentPairIntersection<Scalar>> intersectAllSegmentsTolerance(
+    const std::vector<Segment2D<Scalar>>& segments, const Scalar& epsilon) {
+    const auto count = static_cast<std::uint32_t>(segments.size());
+    std::vector<std::pair<Point2D<Scalar>, std::uint32_t>> endpoints;
+    endpoints.reserve(2 * static_cast<std::size_t>(count));
+    std::vector<Scalar> lengths(count);
+    Scalar longest{};
+    for (std::uint32_t index = 0; index < count; ++index) {
+        endpoints.emplace_back(segments[index].start, index);
+        endpoints.emplace_back(segments[index].end, index);
+        lengths[index] = sqrtValue(squaredLength(subtract(segments[index].end, segments[index].start)));
+        longest = std::max(longest, lengths[index]);
+    }
+
+    std::sort(endpoints.begin(), endpoints.end(),
+              [](const auto& lhs, const auto& rhs) { return lexLessExact(lhs.first, rhs.first); });
+    // CSR lists of the segments ending at each distinct point, with the point's reach.
+    std::vector<Point2D<Scalar>> points;
+    std::vector<Scalar> reaches;
+    std::vector<std::uint32_t> ownerStart;
+    std::vector<std::uint32_t> owners;
+    owners.reserve(endpoints.size());
+    for (std::size_t index = 0; index < endpoints.size(); ++index) {
+        const auto& point = endpoints[index].first;
+        if (index == 0 || !pointsIdentical(endpoints[index - 1].first, point)) {
+            ownerStart.push_back(static_cast<std::uint32_t>(owners.size()));
+            points.push_back(point);
+            reaches.emplace_back();
+        }
+        const Scalar& own = lengths[endpoints[index].second];
+        const Scalar reach = Scalar{2} * epsilon * (own + longest + Scalar{1}) * std::max(own, Scalar{1});
+        reaches.back() = std::max(reaches.back(), reach);
+        owners.push_back(endpoints[index].second);
+    }
+    ownerStart.push_back(static_cast<std::uint32_t>(owners.size()));
+
+    std::vector<Segment2D<Scalar>> probed = segments;
+    probed.reserve(segments.size() + 2 * points.size());
+    for (std::size_t index = 0; index < points.size(); ++index) {
+        const auto& point = points[index];
+        const Scalar& reach = reaches[index];
+        probed.push_back({{point.x - reach, point.y - reach}, {point.x + reach, point.y + reach}});
+        probed.push_back({{point.x - reach, point.y + reach}, {point.x + reach, point.y - reach}});
+    }
+    if (probed.size() >= NoIndex - 1) {
+        throw std::invalid_argument("intersectAllSegments: too many segments");
+    }
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> candidates;
+    const auto addOwners = [&](std::uint32_t firstPoint, std::uint32_t secondPoint) {
+        for (std::uint32_t i = ownerStart[firstPoint]; i < ownerStart[firstPoint + 1]; ++i) {
+            for (std::uint32_t j = ownerStart[secondPoint]; j < ownerStart[secondPoint + 1]; ++j) {
+                if (owners[i] != owners[j]) {
+                    candidates.emplace_back(std::min(owners[i], owners[j]), std::max(owners[i], owners[j]));
+                }
+            }
+        }
+    };
+
+    const auto probeCandidates = SegmentSweep<Scalar>(probed, epsilon, PredicateKernel::Filtered).run();
+    candidates.reserve(probeCandidates.size());
+    for (const auto& candidate : probeCandidates) {
+        const std::uint32_t first = candidate.first;
+        const std::uint32_t second = candidate.second;
+        if (first < count && second < count) {
+            candidates.emplace_back(std::min(first, second), std::max(first, second));
+        } else if (first >= count && second >= count) {
+            addOwners((first - count) / 2, (second - count) / 2);
+        } else {
+            const std::uint32_t segment = std::min(first, second);
+            const std::uint32_t point = (std::max(first, second) - count) / 2;
+            for (std::uint32_t slot = ownerStart[point]; slot < ownerStart[point + 1]; ++slot) {
+                if (owners[slot] != segment) {
+                    candidates.emplace_back(std::min(segment, owners[slot]), std::max(segment, owners[slot]));
+                }
+            }
+        }
+    }
+
+    // Endpoints inside another endpoint's box, looking both ways from every point.
+    const auto pointCount = static_cast<std::uint32_t>(points.size());
+    for (std::uint32_t index = 0; index < pointCount; ++index) {
+        const auto& point = points[index];
+        const Scalar& reach = reaches[index];
+        for (std::uint32_t other = index + 1; other < pointCount && points[other].x - point.x <= reach; ++other) {
+            if (absValue(points[other].y - point.y) <= reach) {
+                addOwners(index, other);
+            }
+        }
+        for (std::uint32_t other = index; other > 0 && point.x - points[other - 1].x <= reach; --other) {
+            if (absValue(points[other - 1].y - point.y) <= reach) {
+                addOwners(other - 1, index);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<SegmentPairIntersection<Scalar>> intersections;
+    for (const auto& candidate : candidates) {
+        const auto result = intersectSegments(segments[candidate.first], segments[candidate.second], epsilon,
+                                              PredicateKernel::Tolerance);
+        if (result.type != IntersectionType::None) {
+            intersections.push_back({candidate.first, candidate.second, result});
+        }
+    }
+    return intersections;
+}
+
+// An edge of the planar arrangement of the boolean operands. toggles has bit 0 set when the
+// edge flips membership in operand A under the even-odd rule and bit 1 for operand B; above
+// holds the membership of the region on its left, start being the lexicographically smaller
+// end.
+struct ArrangementEdge {
+    std::uint32_t start{};
+    std::uint32_t end{};
+    unsigned toggles{};
+    unsigned above{};
+};
+
+// Split and welded edges of two boolean operands, with the membership on both sides of each
+// edge already known; every operation is read off the same arrangement.
+template <typename Scalar>
+struct Arrangement {
+    std::vector<Point2D<Scalar>> vertices;
+    std::vector<ArrangementEdge> edges;
+};
+
+// Contour edges of a region tagged with the operand bit; every contour, outer or hole, counts
+// under the even-odd rule.
+template <typename Scalar>
+void appendContourEdges(const BooleanResult<Scalar>& region,
+                        unsigned operand,
+                        std::vector<Segment2D<Scalar>>& segments,
+                        std::vector<unsigned>& toggles) {
+    for (const auto* contours : {&region.outers, &region.holes}) {
+        for (const auto& contour : *contours) {
+            if (contour.size() < 3) {
+                continue;
+            }
+            for (std::size_t i = 0; i < contour.size(); ++i) {
+                const auto& start = contour[i];
+                const auto& end = contour[(i + 1) % contour.size()];
+                if (!pointsIdentical(start, end)) {
+                    segments.push_back({start, end});
+                    toggles.push_back(operand);
+                }
+            }
+        }
+    }
+}
+
+// Splits every contour edge at its intersections with all other edges and welds the pieces
+// into a shared vertex array. Pieces covering the same vertex pair are merged, their toggles
+// cancelling in pairs, so the edges only meet at their ends.
+template <typename Scalar>
+void buildArrangement(const std::vector<Segment2D<Scalar>>& segments,
+                      const std::vector<unsigned>& toggles,
+                      const Scalar& eps,
+                      PredicateKernel kernel,
+                      std::vector<Point2D<Scalar>>& vertices,
+                      std::vector<ArrangementEdge>& edges) {
+    std::vector<std::vector<Point2D<Scalar>>> splits(segments.size());
+    for (const auto& hit : intersectAllSegments(segments, eps, kernel)) {
+        for (const auto index : {hit.first, hit.second}) {
+            if (hit.result.type == IntersectionType::Point) {
+                splits[index].push_back(hit.result.point);
+            } else {
+                splits[index].push_back(hit.result.overlap.start);
+                splits[index].push_back(hit.result.overlap.end);
+            }
+        }
+    }
+
+    VertexWelder<Scalar> welder(eps, segments.size() * 2);
+    std::vector<std::pair<std::uint64_t, unsigned>> pieces;
+    pieces.reserve(segments.size());
+    std::vector<std::pair<Scalar, std::uint32_t>> stops;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        const auto& segment = segments[i];
+        const auto direction = subtract(segment.end, segment.start);
+        stops.clear();
+        stops.emplace_back(Scalar{}, static_cast<std::uint32_t>(welder.weld(segment.start)));
+        stops.emplace_back(squaredLength(direction), static_cast<std::uint32_t>(welder.weld(segment.end)));
+        for (const auto& point : splits[i]) {
+            stops.emplace_back(dot(subtract(point, segment.start), direction),
+                               static_cast<std::uint32_t>(welder.weld(point)));
+        }
+        std::sort(stops.begin(), stops.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        for (std::size_t j = 0; j + 1 < stops.size(); ++j) {
+            std::uint32_t u = stops[j].second;
+            std::uint32_t v = stops[j + 1].second;
+            if (u == v) {
+                continue;
+            }
+            if (v < u) {
+                std::swap(u, v);
+            }
+            pieces.emplace_back((static_cast<std::uint64_t>(u) << 32) | v, toggles[i]);
+        }
+    }
+
+    vertices = welder.points();
+    edges.clear();
+    std::sort(pieces.begin(), pieces.end());
+    for (std::size_t i = 0; i < pieces.size();) {
+        unsigned merged = 0;
+        std::size_t j = i;
+        for (; j < pieces.size() && pieces[j].first == pieces[i].first; ++j) {
+            merged ^= pieces[j].second;
+        }
+        if (merged != 0) {
+            auto u = static_cast<std::uint32_t>(pieces[i].first >> 32);
+            auto v = static_cast<std::uint32_t>(pieces[i].first);
+            if (lexLessExact(vertices[v], vertices[u])) {
+                std::swap(u, v);
+            }
+            edges.push_back({u, v, merged, 0});
+        }
+        i = j;
+    }
+}
+
+// Sweeps the arrangement in lexicographic order and sets the membership above every edge
+// from the edge directly below it. Edges only meet at their ends, so the status is ordered by
+// exact orientation tests against the vertices themselves, whatever the kernel: the tolerance
+// only decides which edges meet, not the order of edges that do not.
+template <typename Scalar>
+class ArrangementSweep {
+public:
+    ArrangementSweep(const std::vector<Point2D<Scalar>>& vertices, std::vector<ArrangementEdge>& edges)
+        : m_vertices(vertices),
+          m_edges(edges),
+          m_status(StatusLess{this}),
+          m_handles(edges.size()) {}
+
+    void run() {
+        std::vector<std::vector<std::uint32_t>> starting(m_vertices.size());
+        std::vector<std::vector<std::uint32_t>> ending(m_vertices.size());
+        for (std::uint32_t index = 0; index < m_edges.size(); ++index) {
+            starting[m_edges[index].start].push_back(index);
+            ending[m_edges[index].end].push_back(index);
+        }
+        std::vector<std::uint32_t> order(m_vertices.size());
+        for (std::uint32_t index = 0; index < order.size(); ++index) {
+            order[index] = index;
+        }
+        std::sort(order.begin(), order.end(), [this](std::uint32_t lhs, std::uint32_t rhs) {
+            return lexLessExact(m_vertices[lhs], m_vertices[rhs]);
+        });
+
+        for (const auto vertex : order) {
+            for (const auto edge : ending[vertex]) {
+                m_status.erase(m_handles[edge]);
+            }
+            // Bottom to top, so each edge finds the one below it already in the status.
+            auto& group = starting[vertex];
+            std::sort(group.begin(), group.end(), [this, vertex](std::uint32_t lhs, std::uint32_t rhs) {
+                const int turn = orientation(vertex, m_edges[lhs].end, m_edges[rhs].end);
+                return turn != 0 ? turn > 0 : lhs < rhs;
+            });
+            for (const auto edge : group) {
+                const auto it = m_status.insert(edge);
+                m_handles[edge] = it;
+                const unsigned below = it == m_status.begin() ? 0u : m_edges[*std::prev(it)].above;
+                m_edges[edge].above = below ^ m_edges[edge].toggles;
+            }
+        }
+    }
+
+private:
+    struct StatusLess {
+        const ArrangementSweep* sweep;
+
+        bool operator()(std::uint32_t lhs, std::uint32_t rhs) const {
+            return sweep->below(lhs, rhs);
+        }
+    };
+
+    using Status = std::multiset<std::uint32_t, StatusLess>;
+
+    int orientation(std::uint32_t a, std::uint32_t b, std::uint32_t c) const {
+        return filteredOrientationSign(m_vertices[a], m_vertices[b], m_vertices[c]);
+    }
+
+    // Compares the later edge against the line of the earlier one, at the later start.
+    bool below(std::uint32_t lhs, std::uint32_t rhs) const {
+        if (lhs == rhs) {
+            return false;
+        }
+        const auto& first = m_edges[lhs];
+        const auto& second = m_edges[rhs];
+        const bool lhsLater = lexLessExact(m_vertices[second.start], m_vertices[first.start]);
+        const auto& earlier = lhsLater ? second : first;
+        const auto& later = lhsLater ? first : second;
+        int side = orientation(earlier.start, earlier.end, later.start);
+        if (side == 0) {
+            side = orientation(earlier.start, earlier.end, later.end);
+        }
+        if (side == 0) {
+            return lhs < rhs;
+        }
+        return lhsLater ? side < 0 : side > 0;
+    }
+
+    const std::vector<Point2D<Scalar>>& m_vertices;
+    std::vector<ArrangementEdge>& m_edges;
+    Status m_status;
+    std::vector<typename Status::iterator> m_handles;
+};
+
+inline bool insideBooleanResult(unsigned membership, BooleanOperation operation) {
+    const bool inA = (membership & 1u) != 0;
+    const bool inB = (membership & 2u) != 0;
+    switch (operation) {
+    case BooleanOperation::Union:
+        return inA || inB;
+    case BooleanOperation::Intersection:
+        return inA && inB;
+    case BooleanOperation::Difference:
+        return inA && !inB;
+    case BooleanOperation::Xor:
+        return inA != inB;
+    }
+    return false;
+}
+
+// Links the boundary edges of the result, oriented with the result on their left, into
+// contours. At each vertex the walk takes the first outgoing edge clockwise from the way back,
+// which closes the tightest loop and splits contours that only touch at a vertex.
+template <typename Scalar>
+BooleanResult<Scalar> traceBooleanContours(const std::vector<Point2D<Scalar>>& vertices,
+                                           const std::vector<ArrangementEdge>& edges,
+                                           BooleanOperation operation,
+                                           const Scalar& eps,
+                                           PredicateKernel kernel) {
+    struct Directed {
+        std::uint32_t from;
+        std::uint32_t to;
+        double angle;
+    };
+    std::vector<Directed> boundary;
+    for (const auto& edge : edges) {
+        const bool above = insideBooleanResult(edge.above, operation);
+        const bool below = insideBooleanResult(edge.above ^ edge.toggles, operation);
+        if (above == below) {
+            continue;
+        }
+        const std::uint32_t from = above ? edge.start : edge.end;
+        const std::uint32_t to = above ? edge.end : edge.start;
+        const auto direction = subtract(vertices[to], vertices[from]);
+        boundary.push_back({from, to, std::atan2(toDouble(direction.y), toDouble(direction.x))});
+    }
+
+    std::vector<std::vector<std::uint32_t>> outgoing(vertices.size());
+    for (std::uint32_t index = 0; index < boundary.size(); ++index) {
+        outgoing[boundary[index].from].push_back(index);
+    }
+
+    constexpr double Pi = 3.14159265358979323846;
+    const auto nextEdge = [&](std::uint32_t edge) {
+        const auto& current = boundary[edge];
+        const double back = current.angle > 0.0 ? current.angle - Pi : current.angle + Pi;
+        std::uint32_t best = NoIndex;
+        double bestTurn = std::numeric_limits<double>::infinity();
+        for (const auto candidate : outgoing[current.to]) {
+            double turn = back - boundary[candidate].angle;
+            while (turn <= 0.0) {
+                turn += 2.0 * Pi;
+            }
+            if (turn < bestTurn) {
+                bestTurn = turn;
+                best = candidate;
+            }
+        }
+        return best;
+    };
+
+    BooleanResult<Scalar> result;
+    std::vector<unsigned char> used(boundary.size(), 0);
+    for (std::uint32_t first = 0; first < boundary.size(); ++first) {
+        if (used[first] != 0) {
+            continue;
+        }
+        Polygon<Scalar> contour;
+        std::uint32_t edge = first;
+        bool closed = false;
+        while (edge != NoIndex && used[edge] == 0) {
+            used[edge] = 1;
+            contour.push_back(vertices[boundary[edge].from]);
+            edge = nextEdge(edge);
+            closed = edge == first;
+        }
+        if (!closed) {
+            continue;
+        }
+        contour = removeColinearSpikes(removeDuplicateVertices(contour, eps), eps, kernel);
+        if (contour.size() < 3) {
+            continue;
+        }
+        const Scalar area = signedArea(contour);
+        if (absValue(area) <= eps) {
+            continue;
+        }
+        (area > Scalar{} ? result.outers : result.holes).push_back(std::move(contour));
+    }
+    return result;
+}
+
+// Unions the polygons order[lo, hi) as a balanced tree. Neighbours along the Hilbert order
+// merge first, so intermediate results stay compact and most of their shared edges cancel
+// early. The top parallelDepth levels run their left half on another thread.
+template <typename Scalar>
+BooleanResult<Scalar> cascadeUnion(const std::vector<Polygon<Scalar>>& polygons,
+                                   const std::vector<std::uint32_t>& order,
+                                   std::size_t lo,
+                                   std::size_t hi,
+                                   const Scalar& eps,
+                                   PredicateKernel kernel,
+                                   unsigned parallelDepth) {
+    if (hi - lo == 1) {
+        BooleanResult<Scalar> region;
+        region.outers.push_back(polygons[order[lo]]);
+        return booleanOperation(region, BooleanResult<Scalar>{}, BooleanOperation::Union, eps, kernel);
+    }
+    if (hi - lo == 2) {
+        return booleanOperation(polygons[order[lo]], polygons[order[lo + 1]], BooleanOperation::Union, eps, kernel);
+    }
+
+    constexpr std::size_t MinParallelCount = 64;
+    const std::size_t mid = lo + (hi - lo) / 2;
+    BooleanResult<Scalar> left;
+    BooleanResult<Scalar> right;
+    if (parallelDepth > 0 && hi - lo >= MinParallelCount) {
+        auto pending = std::async(std::launch::async, [&] {
+            return cascadeUnion(polygons, order, lo, mid, eps, kernel, parallelDepth - 1);
+        });
+        right = cascadeUnion(polygons, order, mid, hi, eps, kernel, parallelDepth - 1);
+        left = pending.get();
+    } else {
+        left = cascadeUnion(polygons, order, lo, mid, eps, kernel, 0);
+        right = cascadeUnion(polygons, order, mid, hi, eps, kernel, 0);
+    }
+    return booleanOperation(left, right, BooleanOperation::Union, eps, kernel);
+}
+
+// Structure-of-arrays copy of a double polygon's edges for the batch point-in-polygon kernels.
+// [bandLow, bandHigh] widens each edge's y-range to cover every point the scalar boundary test
+// could accept, and lengthTerm is |edge|^2 + 1 for the tolerance kernel's cross bound.
+struct EdgeBatch {
+    std::vector<double> startX;
+    std::vector<double> startY;
+    std::vector<double> deltaX;
+    std::vector<double> deltaY;
+    std::vector<double> endY;
+    std::vector<double> bandLow;
+    std::vector<double> bandHigh;
+    std::vector<double> lengthTerm;
+};
+
+// Fails on non-finite input, which is left to the scalar predicates.
+inline bool buildEdgeBatch(const Polygon<double>& polygon, double eps, PredicateKernel kernel, EdgeBatch& batch) {
+    const std::size_t n = polygon.size();
+    for (auto* column : {&batch.startX, &batch.startY, &batch.deltaX, &batch.deltaY, &batch.endY, &batch.bandLow,
+                         &batch.bandHigh, &batch.lengthTerm}) {
+        column->resize(n);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& start = polygon[i];
+        const auto& end = polygon[(i + 1) % n];
+        const double deltaX = end.x - start.x;
+        const double deltaY = end.y - start.y;
+        const double lengthSquared = deltaX * deltaX + deltaY * deltaY;
+        double margin = 0.0;
+        double lengthTerm = lengthSquared + 1.0;
+        if (kernel == PredicateKernel::Tolerance) {
+            // The tolerance boundary test accepts points up to eps * (|e|^2 + 1) / |e| off the
+            // line and eps / |e| past either end; short edges fall back to the scalar test.
+            const double length = std::sqrt(lengthSquared);
+            if (lengthSquared <= eps * eps) {
+                margin = eps;
+                lengthTerm = std::numeric_limits<double>::infinity();
+            } else {
+                margin = eps * (lengthSquared + 2.0) / length;
+            }
+            margin = margin * (1.0 + 1e-9) + 1e-12 * (std::fabs(start.y) + std::fabs(end.y) + length) +
+                     std::numeric_limits<double>::min();
+        }
+        batch.startX[i] = start.x;
+        batch.startY[i] = start.y;
+        batch.deltaX[i] = deltaX;
+        batch.deltaY[i] = deltaY;
+        batch.endY[i] = end.y;
+        batch.bandLow[i] = std::min(start.y, end.y) - margin;
+        batch.bandHigh[i] = std::max(start.y, end.y) + margin;
+        batch.lengthTerm[i] = lengthTerm;
+        if (!std::isfinite(start.x) || !std::isfinite(start.y) || !std::isfinite(lengthSquared) ||
+            !std::isfinite(margin)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every lane accumulates the crossing-number winding over all edges and raises its uncertain bit
+// when some edge in its band cannot be decided in plain double arithmetic: the cross product is
+// within the tolerance (or the rounding error bound of an exact sign), so the point may be on
+// the boundary or on the wrong side of a near-degenerate edge.
+constexpr double BatchRoundingFactor = 4e-15;
+constexpr double BatchToleranceSlack = 1.0 + 1e-12;
+constexpr double BatchMinimumBound = 1e-300;
+
+#if defined(PLANE_GEOMETRY_HAS_AVX2)
+__attribute__((target("avx2"))) inline int classifyBlockAvx2(const EdgeBatch& batch,
+                                                              double toleranceEps,
+                                                              const double* xs,
+                                                              const double* ys,
+                                                              double* winding) {
+    const __m256d x = _mm256_loadu_pd(xs);
+    const __m256d y = _mm256_loadu_pd(ys);
+    const __m256d eps = _mm256_set1_pd(toleranceEps);
+    const __m256d slack = _mm256_set1_pd(BatchToleranceSlack);
+    const __m256d rounding = _mm256_set1_pd(BatchRoundingFactor);
+    const __m256d minimum = _mm256_set1_pd(BatchMinimumBound);
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    __m256d accumulator = zero;
+    __m256d uncertain = zero;
+    for (std::size_t i = 0; i < batch.startX.size(); ++i) {
+        const __m256d startY = _mm256_set1_pd(batch.startY[i]);
+        const __m256d endY = _mm256_set1_pd(batch.endY[i]);
+        const __m256d toPointX = _mm256_sub_pd(x, _mm256_set1_pd(batch.startX[i]));
+        const __m256d toPointY = _mm256_sub_pd(y, startY);
+        const __m256d lhs = _mm256_mul_pd(_mm256_set1_pd(batch.deltaX[i]), toPointY);
+        const __m256d rhs = _mm256_mul_pd(_mm256_set1_pd(batch.deltaY[i]), toPointX);
+        const __m256d crossValue = _mm256_sub_pd(lhs, rhs);
+
+        const __m256d toPointSquared =
+            _mm256_add_pd(_mm256_mul_pd(toPointX, toPointX), _mm256_mul_pd(toPointY, toPointY));
+        const __m256d tolerance =
+            _mm256_mul_pd(eps, _mm256_add_pd(_mm256_set1_pd(batch.lengthTerm[i]), toPointSquared));
+        const __m256d roundingBound = _mm256_mul_pd(
+            rounding, _mm256_add_pd(_mm256_andnot_pd(signMask, lhs), _mm256_andnot_pd(signMask, rhs)));
+        const __m256d bound =
+            _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(tolerance, slack), roundingBound), minimum);
+        const __m256d certain = _mm256_cmp_pd(_mm256_andnot_pd(signMask, crossValue), bound, _CMP_GT_OQ);
+        const __m256d inBand = _mm256_and_pd(_mm256_cmp_pd(y, _mm256_set1_pd(batch.bandLow[i]), _CMP_GE_OQ),
+                                             _mm256_cmp_pd(y, _mm256_set1_pd(batch.bandHigh[i]), _CMP_LE_OQ));
+        uncertain = _mm256_or_pd(uncertain, _mm256_andnot_pd(certain, inBand));
+
+        const __m256d upward =
+            _mm256_and_pd(_mm256_cmp_pd(startY, y, _CMP_LE_OQ), _mm256_cmp_pd(endY, y, _CMP_GT_OQ));
+        const __m256d downward =
+            _mm256_and_pd(_mm256_cmp_pd(startY, y, _CMP_GT_OQ), _mm256_cmp_pd(endY, y, _CMP_LE_OQ));
+        const __m256d left = _mm256_and_pd(upward, _mm256_cmp_pd(crossValue, zero, _CMP_GT_OQ));
+        const __m256d right = _mm256_and_pd(downward, _mm256_cmp_pd(crossValue, zero, _CMP_LT_OQ));
+        accumulator = _mm256_add_pd(accumulator, _mm256_and_pd(left, one));
+        accumulator = _mm256_sub_pd(accumulator, _mm256_and_pd(right, one));
+    }
+    _mm256_storeu_pd(winding, accumulator);
+    return _mm256_movemask_pd(uncertain);
+}
+
+inline bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+#if defined(PLANE_GEOMETRY_HAS_SSE2)
+inline int classifyBlockSse2(const EdgeBatch& batch,
+                             double toleranceEps,
+                             const double* xs,
+                             const double* ys,
+                             double* winding) {
+    const __m128d x = _mm_loadu_pd(xs);
+    const __m128d y = _mm_loadu_pd(ys);
+    const __m128d eps = _mm_set1_pd(toleranceEps);
+    const __m128d slack = _mm_set1_pd(BatchToleranceSlack);
+    const __m128d rounding = _mm_set1_pd(BatchRoundingFactor);
+    const __m128d minimum = _mm_set1_pd(BatchMinimumBound);
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+    __m128d accumulator = zero;
+    __m128d uncertain = zero;
+    for (std::size_t i = 0; i < batch.startX.size(); ++i) {
+        const __m128d startY = _mm_set1_pd(batch.startY[i]);
+        const __m128d endY = _mm_set1_pd(batch.endY[i]);
+        const __m128d toPointX = _mm_sub_pd(x, _mm_set1_pd(batch.startX[i]));
+        const __m128d toPointY = _mm_sub_pd(y, startY);
+        const __m128d lhs = _mm_mul_pd(_mm_set1_pd(batch.deltaX[i]), toPointY);
+        const __m128d rhs = _mm_mul_pd(_mm_set1_pd(batch.deltaY[i]), toPointX);
+        const __m128d crossValue = _mm_sub_pd(lhs, rhs);
+
+        const __m128d toPointSquared = _mm_add_pd(_mm_mul_pd(toPointX, toPointX), _mm_mul_pd(toPointY, toPointY));
+        const __m128d tolerance = _mm_mul_pd(eps, _mm_add_pd(_mm_set1_pd(batch.lengthTerm[i]), toPointSquared));
+        const __m128d roundingBound =
+            _mm_mul_pd(rounding, _mm_add_pd(_mm_andnot_pd(signMask, lhs), _mm_andnot_pd(signMask, rhs)));
+        const __m128d bound = _mm_add_pd(_mm_add_pd(_mm_mul_pd(tolerance, slack), roundingBound), minimum);
+        const __m128d certain = _mm_cmpgt_pd(_mm_andnot_pd(signMask, crossValue), bound);
+        const __m128d inBand = _mm_and_pd(_mm_cmpge_pd(y, _mm_set1_pd(batch.bandLow[i])),
+                                          _mm_cmple_pd(y, _mm_set1_pd(batch.bandHigh[i])));
+        uncertain = _mm_or_pd(uncertain, _mm_andnot_pd(certain, inBand));
+
+        const __m128d upward = _mm_and_pd(_mm_cmple_pd(startY, y), _mm_cmpgt_pd(endY, y));
+        const __m128d downward = _mm_and_pd(_mm_cmpgt_pd(startY, y), _mm_cmple_pd(endY, y));
+        const __m128d left = _mm_and_pd(upward, _mm_cmpgt_pd(crossValue, zero));
+        const __m128d right = _mm_and_pd(downward, _mm_cmplt_pd(crossValue, zero));
+        accumulator = _mm_add_pd(accumulator, _mm_and_pd(left, one));
+        accumulator = _mm_sub_pd(accumulator, _mm_and_pd(right, one));
+    }
+    _mm_storeu_pd(winding, accumulator);
+    return _mm_movemask_pd(uncertain);
+}
+#endif
+
+// Batch classification for double polygons. Returns false when no vector kernel is available
+// or the input is not finite, leaving result untouched for the scalar path.
+inline bool locatePointsInPolygonBatch(const Polygon<double>& polygon,
+                                       const std::vector<Point2D<double>>& points,
+                                       double eps,
+                                       PredicateKernel kernel,
+                                       std::vector<PointClassification>& result) {
+    using BlockKernel = int (*)(const EdgeBatch&, double, const double*, const double*, double*);
+    BlockKernel blockKernel = nullptr;
+    std::size_t lanes = 0;
+#if defined(PLANE_GEOMETRY_HAS_AVX2)
+    if (cpuHasAvx2()) {
+        blockKernel = classifyBlockAvx2;
+        lanes = 4;
+    }
+#endif
+#if defined(PLANE_GEOMETRY_HAS_SSE2)
+    if (blockKernel == nullptr) {
+        blockKernel = classifyBlockSse2;
+        lanes = 2;
+    }
+#endif
+    const bool tolerance = kernel == PredicateKernel::Tolerance;
+    if (blockKernel == nullptr || (tolerance && !(eps >= 0.0 && std::isfinite(eps)))) {
+        return false;
+    }
+    EdgeBatch batch;
+    if (!buildEdgeBatch(polygon, eps, kernel, batch)) {
+        return false;
+    }
+
+    result.resize(points.size());
+    std::array<double, 4> xs{};
+    std::array<double, 4> ys{};
+    std::array<double, 4> winding{};
+    for (std::size_t first = 0; first < points.size(); first += lanes) {
+        const std::size_t count = std::min(lanes, points.size() - first);
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            const auto& point = points[first + std::min(lane, count - 1)];
+            xs[lane] = point.x;
+            ys[lane] = point.y;
+        }
+        const int uncertain = blockKernel(batch, tolerance ? eps : 0.0, xs.data(), ys.data(), winding.data());
+        for (std::size_t lane = 0; lane < count; ++lane) {
+            const auto& point = points[first + lane];
+            if ((uncertain >> lane) & 1 || !std::isfinite(point.x) || !std::isfinite(point.y)) {
+                result[first + lane] = locatePointInPolygon(polygon, point, eps, kernel);
+            } else {
+                result[first + lane] = winding[lane] != 0.0 ? PointClassification::Inside : PointClassification::Outside;
+            }
+        }
+    }
+    return true;
+}
+
+// Randomized incremental trapezoidal map (de Berg et al., ch. 6) over segments that meet only at
+// shared endpoints, with its search DAG. Points are ordered lexicographically, a symbolic shear
+// that removes vertical segments and shared x coordinates as special cases. A trapezoid has at
+// most two neighbours per side: when its wall runs both above and below leftp they are
+// upperLeft and lowerLeft, when it runs only one way the single neighbour sits on that side.
+template <typename Scalar>
+class TrapezoidDecomposition {
+public:
+    struct Segment {
+        std::uint32_t left;
+        std::uint32_t right;
+        std::uint32_t aboveFace;
+        std::uint32_t belowFace;
+    };
+
+    TrapezoidDecomposition(std::vector<Point2D<Scalar>> vertices, std::vector<Segment> segments)
+        : m_vertices(std::move(vertices)),
+          m_segments(std::move(segments)),
+          m_vertexFaces(m_vertices.size(), NoIndex) {
+        m_trapezoids.reserve(3 * m_segments.size() + 1);
+        m_nodes.reserve(9 * m_segments.size() + 1);
+        addTrapezoid(NoIndex, NoIndex, NoIndex, NoIndex);
+        for (const auto& segment : m_segments) {
+            const std::uint32_t face = segment.aboveFace != NoIndex ? segment.aboveFace : segment.belowFace;
+            for (const auto vertex : {segment.left, segment.right}) {
+                if (m_vertexFaces[vertex] == NoIndex) {
+                    m_vertexFaces[vertex] = face;
+                }
+            }
+        }
+    }
+
+    void build(std::mt19937& generator) {
+        std::vector<std::uint32_t> order(m_segments.size());
+        for (std::uint32_t index = 0; index < order.size(); ++index) {
+            order[index] = index;
+        }
+        std::shuffle(order.begin(), order.end(), generator);
+        for (const auto segment : order) {
+            insert(segment);
+        }
+    }
+
+    // Trapezoid holding the point. A point exactly on a segment is sent above it and one exactly
+    // on a vertex to its right; the last such segment and vertex met on the way are kept.
+    struct Location {
+        std::uint32_t trapezoid;
+        std::uint32_t segment{NoIndex};
+        std::uint32_t vertex{NoIndex};
+    };
+
+    Location find(const Point2D<Scalar>& point) const {
+        Location location{NoIndex};
+        std::uint32_t current = 0;
+        while (m_nodes[current].kind != NodeKind::Leaf) {
+            const auto& node = m_nodes[current];
+            if (node.kind == NodeKind::XNode) {
+                const auto& vertex = m_vertices[node.index];
+                if (lexLessExact(point, vertex)) {
+                    current = node.first;
+                    continue;
+                }
+                if (pointsIdentical(point, vertex)) {
+                    location.vertex = node.index;
+                }
+                current = node.second;
+            } else {
+                const auto& segment = m_segments[node.index];
+                const int side = filteredOrientationSign(m_vertices[segment.left], m_vertices[segment.right], point);
+                if (side == 0) {
+                    location.segment = node.index;
+                }
+                current = side >= 0 ? node.first : node.second;
+            }
+        }
+        location.trapezoid = m_nodes[current].index;
+        return location;
+    }
+
+    // Points on the boundary of a face take that face even when the walk ends on the unlabelled
+    // side: below the segment they lie on, or any face around the vertex they sit on.
+    std::uint32_t locate(const Point2D<Scalar>& point) const {
+        const Location location = find(point);
+        const std::uint32_t label = face(location.trapezoid);
+        if (label != NoIndex) {
+            return label;
+        }
+        if (location.segment != NoIndex && m_segments[location.segment].belowFace != NoIndex) {
+            return m_segments[location.segment].belowFace;
+        }
+        return location.vertex != NoIndex ? m_vertexFaces[location.vertex] : NoIndex;
+    }
+
+    std::uint32_t face(std::uint32_t index) const {
+        const auto& trapezoid = m_trapezoids[index];
+        if (trapezoid.top != NoIndex) {
+            return m_segments[trapezoid.top].belowFace;
+        }
+        return trapezoid.bottom != NoIndex ? m_segments[trapezoid.bottom].aboveFace : NoIndex;
+    }
+
+    // True when the disk of the given radius around a point of the trapezoid stays clear of its
+    // walls and of the lines through its top and bottom, so no segment comes that close. The
+    // test runs in double with slack for its own rounding and errs towards false.
+    bool holdsDisk(std::uint32_t index, const Point2D<Scalar>& point, double radius) const {
+        const auto& trapezoid = m_trapezoids[index];
+        const double x = toDouble(point.x);
+        const double y = toDouble(point.y);
+        const double slack = 16.0 * std::numeric_limits<double>::epsilon();
+        for (const auto vertex : {trapezoid.leftp, trapezoid.rightp}) {
+            if (vertex != NoIndex) {
+                const double wall = toDouble(m_vertices[vertex].x);
+                if (std::abs(x - wall) <= radius + slack * (std::abs(x) + std::abs(wall))) {
+                    return false;
+                }
+            }
+        }
+        for (const auto segment : {trapezoid.top, trapezoid.bottom}) {
+            if (segment != NoIndex) {
+                const auto& left = m_vertices[m_segments[segment].left];
+                const auto& right = m_vertices[m_segments[segment].right];
+                const double leftX = toDouble(left.x);
+                const double leftY = toDouble(left.y);
+                const double dx = toDouble(right.x) - leftX;
+                const double dy = toDouble(right.y) - leftY;
+                const double scale = std::abs(leftX) + std::abs(leftY) + std::abs(dx) + std::abs(dy) +
+                                     std::abs(x) + std::abs(y);
+                // |dx| + |dy| bounds the segment's length from above.
+                const double bound = (radius + slack * scale) * (std::abs(dx) + std::abs(dy));
+                if (std::abs(dx * (y - leftY) - dy * (x - leftX)) <= bound) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    enum class NodeKind : std::uint8_t { Leaf, XNode, YNode };
+
+    // XNode: first is lexicographically before the vertex. YNode: first is above the segment.
+    struct Node {
+        NodeKind kind;
+        std::uint32_t index;
+        std::uint32_t first;
+        std::uint32_t second;
+    };
+
+    struct Trapezoid {
+        std::uint32_t top;
+        std::uint32_t bottom;
+        std::uint32_t leftp;
+        std::uint32_t rightp;
+        std::uint32_t upperLeft{NoIndex};
+        std::uint32_t lowerLeft{NoIndex};
+        std::uint32_t upperRight{NoIndex};
+        std::uint32_t lowerRight{NoIndex};
+        std::uint32_t node{NoIndex};
+    };
+
+    std::uint32_t addTrapezoid(std::uint32_t top, std::uint32_t bottom, std::uint32_t leftp, std::uint32_t rightp) {
+        const auto index = static_cast<std::uint32_t>(m_trapezoids.size());
+        m_trapezoids.push_back({top, bottom, leftp, rightp});
+        m_trapezoids.back().node = addNode({NodeKind::Leaf, index, NoIndex, NoIndex});
+        return index;
+    }
+
+    std::uint32_t addNode(const Node& node) {
+        if (m_nodes.size() >= NoIndex) {
+            throw std::invalid_argument("TrapezoidalMap: too many edges");
+        }
+        m_nodes.push_back(node);
+        return static_cast<std::uint32_t>(m_nodes.size() - 1);
+    }
+
+    void replaceNeighbor(std::uint32_t trapezoid, std::uint32_t from, std::uint32_t to) {
+        if (trapezoid == NoIndex) {
+            return;
+        }
+        auto& neighbor = m_trapezoids[trapezoid];
+        for (auto* link : {&neighbor.upperLeft, &neighbor.lowerLeft, &neighbor.upperRight, &neighbor.lowerRight}) {
+            if (*link == from) {
+                *link = to;
+            }
+        }
+    }
+
+    int orientation(std::uint32_t a, std::uint32_t b, std::uint32_t c) const {
+        return filteredOrientationSign(m_vertices[a], m_vertices[b], m_vertices[c]);
+    }
+
+    bool precedes(std::uint32_t lhs, std::uint32_t rhs) const {
+        return lexLessExact(m_vertices[lhs], m_vertices[rhs]);
+    }
+
+    bool strictlyInside(std::uint32_t vertex, const Segment& segment, int side) const {
+        return side == 0 && vertex != segment.left && vertex != segment.right && precedes(segment.left, vertex) &&
+               precedes(vertex, segment.right);
+    }
+
+    // True when the two segments share anything but a common endpoint.
+    bool meetOffEndpoints(const Segment& lhs, std::uint32_t other) const {
+        if (other == NoIndex) {
+            return false;
+        }
+        const auto& rhs = m_segments[other];
+        if (lhs.left == rhs.left && lhs.right == rhs.right) {
+            return true;
+        }
+        const int o1 = orientation(lhs.left, lhs.right, rhs.left);
+        const int o2 = orientation(lhs.left, lhs.right, rhs.right);
+        const int o3 = orientation(rhs.left, rhs.right, lhs.left);
+        const int o4 = orientation(rhs.left, rhs.right, lhs.right);
+        if (o1 * o2 < 0 && o3 * o4 < 0) {
+            return true;
+        }
+        return strictlyInside(rhs.left, lhs, o1) || strictlyInside(rhs.right, lhs, o2) ||
+               strictlyInside(lhs.left, rhs, o3) || strictlyInside(lhs.right, rhs, o4);
+    }
+
+    // Trapezoid just right of the segment's left endpoint, on the segment.
+    std::uint32_t findStart(const Segment& segment) const {
+        std::uint32_t current = 0;
+        while (m_nodes[current].kind != NodeKind::Leaf) {
+            const auto& node = m_nodes[current];
+            if (node.kind == NodeKind::XNode) {
+                const bool before = node.index != segment.left && precedes(segment.left, node.index);
+                current = before ? node.first : node.second;
+                continue;
+            }
+            const auto& other = m_segments[node.index];
+            int side = orientation(other.left, other.right, segment.left);
+            if (side == 0 && other.left == segment.left) {
+                side = orientation(other.left, other.right, segment.right);
+            }
+            if (side == 0) {
+                throw std::invalid_argument("TrapezoidalMap edges may only meet at shared endpoints");
+            }
+            current = side > 0 ? node.first : node.second;
+        }
+        return m_nodes[current].index;
+    }
+
+    void insert(std::uint32_t segmentIndex) {
+        const Segment segment = m_segments[segmentIndex];
+        const std::uint32_t p = segment.left;
+        const std::uint32_t q = segment.right;
+
+        auto& crossed = m_crossed;
+        crossed.assign(1, findStart(segment));
+        for (;;) {
+            const auto& trapezoid = m_trapezoids[crossed.back()];
+            if (meetOffEndpoints(segment, trapezoid.top) || meetOffEndpoints(segment, trapezoid.bottom)) {
+                throw std::invalid_argument("TrapezoidalMap edges may only meet at shared endpoints");
+            }
+            const std::uint32_t r = trapezoid.rightp;
+            if (r == NoIndex || r == q || !precedes(r, q)) {
+                break;
+            }
+            const int side = orientation(p, q, r);
+            const std::uint32_t next = side > 0 ? trapezoid.lowerRight : trapezoid.upperRight;
+            if (side == 0 || next == NoIndex) {
+                throw std::invalid_argument("TrapezoidalMap edges may only meet at shared endpoints");
+            }
+            crossed.push_back(next);
+        }
+
+        const Trapezoid first = m_trapezoids[crossed.front()];
+        const Trapezoid last = m_trapezoids[crossed.back()];
+        const std::uint32_t leftPiece = first.leftp != p ? addTrapezoid(first.top, first.bottom, first.leftp, p) : NoIndex;
+        const std::uint32_t rightPiece = last.rightp != q ? addTrapezoid(last.top, last.bottom, q, last.rightp) : NoIndex;
+        std::uint32_t above = addTrapezoid(first.top, segmentIndex, p, NoIndex);
+        std::uint32_t below = addTrapezoid(segmentIndex, first.bottom, p, NoIndex);
+
+        if (leftPiece != NoIndex) {
+            auto& piece = m_trapezoids[leftPiece];
+            piece.upperLeft = first.upperLeft;
+            piece.lowerLeft = first.lowerLeft;
+            piece.upperRight = above;
+            piece.lowerRight = below;
+            replaceNeighbor(first.upperLeft, crossed.front(), leftPiece);
+            replaceNeighbor(first.lowerLeft, crossed.front(), leftPiece);
+            m_trapezoids[above].upperLeft = leftPiece;
+            m_trapezoids[below].lowerLeft = leftPiece;
+        } else {
+            m_trapezoids[above].upperLeft = first.upperLeft;
+            m_trapezoids[below].lowerLeft = first.lowerLeft;
+            replaceNeighbor(first.upperLeft, crossed.front(), above);
+            replaceNeighbor(first.lowerLeft, crossed.front(), below);
+        }
+
+        // The wall at each crossed rightp survives on its own side of the segment; on the other
+        // side it is cut away and the pieces there merge.
+        auto& pieces = m_pieces;
+        pieces.resize(crossed.size());
+        for (std::size_t j = 0; j < crossed.size(); ++j) {
+            pieces[j] = {above, below};
+            if (j + 1 == crossed.size()) {
+                break;
+            }
+            const Trapezoid current = m_trapezoids[crossed[j]];
+            const Trapezoid next = m_trapezoids[crossed[j + 1]];
+            const std::uint32_t r = current.rightp;
+            if (orientation(p, q, r) > 0) {
+                const std::uint32_t nextAbove = addTrapezoid(next.top, segmentIndex, r, NoIndex);
+                m_trapezoids[above].rightp = r;
+                m_trapezoids[above].upperRight = current.upperRight;
+                m_trapezoids[above].lowerRight = nextAbove;
+                m_trapezoids[nextAbove].upperLeft = next.upperLeft;
+                m_trapezoids[nextAbove].lowerLeft = above;
+                replaceNeighbor(current.upperRight, crossed[j], above);
+                replaceNeighbor(next.upperLeft, crossed[j + 1], nextAbove);
+                above = nextAbove;
+            } else {
+                const std::uint32_t nextBelow = addTrapezoid(segmentIndex, next.bottom, r, NoIndex);
+                m_trapezoids[below].rightp = r;
+                m_trapezoids[below].lowerRight = current.lowerRight;
+                m_trapezoids[below].upperRight = nextBelow;
+                m_trapezoids[nextBelow].lowerLeft = next.lowerLeft;
+                m_trapezoids[nextBelow].upperLeft = below;
+                replaceNeighbor(current.lowerRight, crossed[j], below);
+                replaceNeighbor(next.lowerLeft, crossed[j + 1], nextBelow);
+                below = nextBelow;
+            }
+        }
+
+        m_trapezoids[above].rightp = q;
+        m_trapezoids[below].rightp = q;
+        if (rightPiece != NoIndex) {
+            auto& piece = m_trapezoids[rightPiece];
+            piece.upperLeft = above;
+            piece.lowerLeft = below;
+            piece.upperRight = last.upperRight;
+            piece.lowerRight = last.lowerRight;
+            replaceNeighbor(last.upperRight, crossed.back(), rightPiece);
+            replaceNeighbor(last.lowerRight, crossed.back(), rightPiece);
+            m_trapezoids[above].upperRight = rightPiece;
+            m_trapezoids[below].lowerRight = rightPiece;
+        } else {
+            m_trapezoids[above].upperRight = last.upperRight;
+            m_trapezoids[below].lowerRight = last.lowerRight;
+            replaceNeighbor(last.upperRight, crossed.back(), above);
+            replaceNeighbor(last.lowerRight, crossed.back(), below);
+        }
+
+        // Leaves of the crossed trapezoids become the new search nodes in place.
+        for (std::size_t j = 0; j < crossed.size(); ++j) {
+            Node root{NodeKind::YNode, segmentIndex, m_trapezoids[pieces[j].first].node,
+                      m_trapezoids[pieces[j].second].node};
+            if (j + 1 == crossed.size() && rightPiece != NoIndex) {
+                root = {NodeKind::XNode, q, addNode(root), m_trapezoids[rightPiece].node};
+            }
+            if (j == 0 && leftPiece != NoIndex) {
+                root = {NodeKind::XNode, p, m_trapezoids[leftPiece].node, addNode(root)};
+            }
+            m_nodes[m_trapezoids[crossed[j]].node] = root;
+        }
+    }
+
+    std::vector<Point2D<Scalar>> m_vertices;
+    std::vector<Segment> m_segments;
+    // A labelled face of some segment at each vertex, NoIndex when none has one.
+    std::vector<std::uint32_t> m_vertexFaces;
+    std::vector<Trapezoid> m_trapezoids;
+    std::vector<Node> m_nodes;
+    std::vector<std::uint32_t> m_crossed;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> m_pieces;
+};
+
+struct LexLessExact {
+    template <typename Scalar>
+    bool operator()(const Point2D<Scalar>& lhs, const Point2D<Scalar>& rhs) const {
+        return lexLessExact(lhs, rhs);
+    }
+};
+
+// Welds identical endpoints, orients every edge left to right and builds the map in a random
+// order. Zero-length edges bound nothing and are dropped.
+template <typename Scalar>
+std::unique_ptr<TrapezoidDecomposition<Scalar>> buildTrapezoidDecomposition(
+    const std::vector<SubdivisionEdge<Scalar>>& edges,
+    std::optional<std::uint32_t> seed) {
+    using Segment = typename TrapezoidDecomposition<Scalar>::Segment;
+    std::map<Point2D<Scalar>, std::uint32_t, LexLessExact> ids;
+    std::vector<Point2D<Scalar>> vertices;
+    const auto vertexId = [&](const Point2D<Scalar>& point) {
+        const auto [it, inserted] = ids.emplace(point, static_cast<std::uint32_t>(vertices.size()));
+        if (inserted) {
+            vertices.push_back(point);
+        }
+        return it->second;
+    };
+
+    std::vector<Segment> segments;
+    segments.reserve(edges.size());
+    for (const auto& edge : edges) {
+        if (pointsIdentical(edge.segment.start, edge.segment.end)) {
+            continue;
+        }
+        const std::uint32_t start = vertexId(edge.segment.start);
+        const std::uint32_t end = vertexId(edge.segment.end);
+        if (lexLessExact(edge.segment.start, edge.segment.end)) {
+            segments.push_back({start, end, edge.leftFace, edge.rightFace});
+        } else {
+            segments.push_back({end, start, edge.rightFace, edge.leftFace});
+        }
+    }
+
+    auto map = std::make_unique<TrapezoidDecomposition<Scalar>>(std::move(vertices), std::move(segments));
+    std::mt19937 generator{seed ? *seed : std::random_device{}()};
+    map->build(generator);
+    return map;
+}
+
+// De Casteljau for a runtime degree. Curves of up to InlineBezierPoints control points work in
+// a stack buffer; only longer ones fall back to the heap.
+constexpr std::size_t InlineBezierPoints = 16;
 
 template <typename Scalar>
-bool isPointInsideCircumcircle(const Triangle2D<Scalar>& triangle,
-                               const Point2D<Scalar>& point) {
-    const Scalar ax = triangle.a.x - point.x;
-    const Scalar ay = triangle.a.y - point.y;
-    const Scalar bx = triangle.b.x - point.x;
-    const Scalar by = triangle.b.y - point.y;
-    const Scalar cx = triangle.c.x - point.x;
-    const Scalar cy = triangle.c.y - point.y;
+Point2D<Scalar> evaluateBezierInline(const std::vector<Point2D<Scalar>>& controlPoints, const Scalar& t) {
+    std::array<Point2D<Scalar>, InlineBezierPoints> buffer;
+    std::vector<Point2D<Scalar>> overflow;
+    Point2D<Scalar>* temp = buffer.data();
+    if (controlPoints.size() > InlineBezierPoints) {
+        overflow = controlPoints;
+        temp = overflow.data();
+    } else {
+        std::copy(controlPoints.begin(), controlPoints.end(), temp);
+    }
+    const Scalar oneMinusT = Scalar{1} - t;
 
-    const Scalar det = (ax * ax + ay * ay) * (bx * cy - cx * by)
-                     - (bx * bx + by * by) * (ax * cy - cx * ay)
-                     + (cx * cx + cy * cy) * (ax * by - bx * ay);
+    for (std::size_t level = controlPoints.size(); level > 1; --level) {
+        for (std::size_t i = 0; i < level - 1; ++i) {
+            temp[i].x = oneMinusT * temp[i].x + t * temp[i + 1].x;
+            temp[i].y = oneMinusT * temp[i].y + t * temp[i + 1].y;
+        }
+    }
 
-    const Scalar orient = orientationDet(triangle.a, triangle.b, triangle.c);
-    if (orient > Scalar{}) {
-        return det > Scalar{Epsilon};
+    return temp[0];
+}
+
+// Forward differences of the curve at t for parameter step h, written to points[0..d]; points
+// needs room for 4 (d + 1) entries and scalars for d + 1. They come from the Taylor coefficients
+// a_k at t, read off the de Casteljau levels, as D_k = sum over m >= k of k! S(m, k) a_m h^m
+// with S the Stirling numbers of the second kind. Unlike differencing d + 1 evaluated samples
+// this involves no cancellation between nearby curve points.
+template <typename Scalar>
+void bezierForwardDifferences(const std::vector<Point2D<Scalar>>& controlPoints,
+                              const Scalar& t,
+                              const Scalar& h,
+                              Point2D<Scalar>* points,
+                              Scalar* scalars) {
+    const std::size_t degree = controlPoints.size() - 1;
+    const std::size_t width = degree + 1;
+    Point2D<Scalar>* differences = points;
+    Point2D<Scalar>* level = points + width;
+    Point2D<Scalar>* scratch = points + 2 * width;
+    Point2D<Scalar>* taylor = points + 3 * width;
+
+    // Level m of de Casteljau at t has d - m + 1 points, and C(d, k) times the k-th difference
+    // of its first k + 1 points, k = d - m, is the Taylor coefficient a_k.
+    std::copy(controlPoints.begin(), controlPoints.end(), level);
+    const Scalar oneMinusT = Scalar{1} - t;
+    Scalar binomial{1};
+    for (std::size_t m = 0; m <= degree; ++m) {
+        const std::size_t k = degree - m;
+        if (m > 0) {
+            for (std::size_t i = 0; i <= k; ++i) {
+                level[i].x = oneMinusT * level[i].x + t * level[i + 1].x;
+                level[i].y = oneMinusT * level[i].y + t * level[i + 1].y;
+            }
+            binomial = binomial * static_cast<Scalar>(k + 1) / static_cast<Scalar>(m);
+        }
+        std::copy(level, level + k + 1, scratch);
+        for (std::size_t order = 1; order <= k; ++order) {
+            for (std::size_t i = 0; i + order <= k; ++i) {
+                scratch[i].x = scratch[i + 1].x - scratch[i].x;
+                scratch[i].y = scratch[i + 1].y - scratch[i].y;
+            }
+        }
+        taylor[k] = {binomial * scratch[0].x, binomial * scratch[0].y};
+    }
+
+    // scalars holds row m of k! S(m, k), updated in place: T(m, k) = k (T(m-1, k) + T(m-1, k-1)).
+    Scalar power{1};
+    for (std::size_t m = 0; m <= degree; ++m) {
+        for (std::size_t k = m; k > 0; --k) {
+            scalars[k] = static_cast<Scalar>(k) * ((k < m ? scalars[k] : Scalar{}) + scalars[k - 1]);
+        }
+        scalars[0] = m == 0 ? Scalar{1} : Scalar{};
+        const Point2D<Scalar> term{taylor[m].x * power, taylor[m].y * power};
+        for (std::size_t k = 0; k <= m; ++k) {
+            if (m == k) {
+                differences[k] = {Scalar{}, Scalar{}};
+            }
+            differences[k].x += scalars[k] * term.x;
+            differences[k].y += scalars[k] * term.y;
+        }
+        power *= h;
+    }
+}
+
+// Whether the curve deviates from the chord between its end points by at most tolerance. Two
+// bounds are tried: d (d - 1) / 8 times the largest second difference of the control points
+// bounds the distance to the chord at the same parameter, and the convex hull property bounds it
+// by the control points' distance to the chord. The first is tighter on smooth pieces, the
+// second on nearly straight ones with uneven control spacing.
+template <typename Scalar>
+bool bezierWithinTolerance(const std::vector<Point2D<Scalar>>& controlPoints, const Scalar& tolerance) {
+    const std::size_t degree = controlPoints.size() - 1;
+    const Scalar toleranceSquared = tolerance * tolerance;
+    Scalar secondDifference{};
+    for (std::size_t i = 0; i + 2 <= degree; ++i) {
+        const auto& a = controlPoints[i];
+        const auto& b = controlPoints[i + 1];
+        const auto& c = controlPoints[i + 2];
+        const Point2D<Scalar> difference{a.x - Scalar{2} * b.x + c.x, a.y - Scalar{2} * b.y + c.y};
+        secondDifference = std::max(secondDifference, squaredLength(difference));
+    }
+    const Scalar factor = static_cast<Scalar>(degree * (degree - 1)) / Scalar{8};
+    if (!(factor * factor * secondDifference > toleranceSquared)) {
+        return true;
+    }
+
+    const auto& start = controlPoints.front();
+    const auto& end = controlPoints.back();
+    const auto chord = subtract(end, start);
+    const Scalar chordLengthSquared = squaredLength(chord);
+    for (std::size_t i = 1; i + 1 < controlPoints.size(); ++i) {
+        const auto toPoint = subtract(controlPoints[i], start);
+        const Scalar projection = dot(chord, toPoint);
+        bool within = false;
+        if (projection <= Scalar{} || chordLengthSquared == Scalar{}) {
+            within = !(squaredLength(toPoint) > toleranceSquared);
+        } else if (projection >= chordLengthSquared) {
+            within = !(squaredLength(subtract(controlPoints[i], end)) > toleranceSquared);
+        } else {
+            const Scalar crossValue = cross(chord, toPoint);
+            within = !(crossValue * crossValue > toleranceSquared * chordLengthSquared);
+        }
+        if (!within) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Bernstein weights of a cubic, formed exactly as evaluateBezierCubic forms them.
+template <typename Scalar>
+std::array<Scalar, 4> cubicBernstein(const Scalar& t) {
+    const Scalar oneMinusT = Scalar{1} - t;
+    const Scalar oneMinusTSquared = oneMinusT * oneMinusT;
+    const Scalar tSquared = t * t;
+    const Scalar three = Scalar{3};
+    return {oneMinusTSquared * oneMinusT, three * oneMinusTSquared * t, three * oneMinusT * tSquared, tSquared * t};
+}
+
+static_assert(sizeof(Point2D<double>) == 2 * sizeof(double), "batch kernels store Point2D<double> as two doubles");
+
+#if defined(PLANE_GEOMETRY_HAS_AVX2)
+__attribute__((target("avx2"))) inline void evaluateCubicBlocksAvx2(const CubicBezierBatch<double>& curves,
+                                                                     const std::array<double, 4>& weights,
+                                                                     std::size_t begin,
+                                                                     std::size_t end,
+                                                                     Point2D<double>* row) {
+    const __m256d b0 = _mm256_set1_pd(weights[0]);
+    const __m256d b1 = _mm256_set1_pd(weights[1]);
+    const __m256d b2 = _mm256_set1_pd(weights[2]);
+    const __m256d b3 = _mm256_set1_pd(weights[3]);
+    for (std::size_t i = begin; i < end; i += 4) {
+        __m256d x = _mm256_add_pd(_mm256_mul_pd(b0, _mm256_loadu_pd(curves.x[0].data() + i)),
+                                  _mm256_mul_pd(b1, _mm256_loadu_pd(curves.x[1].data() + i)));
+        x = _mm256_add_pd(x, _mm256_mul_pd(b2, _mm256_loadu_pd(curves.x[2].data() + i)));
+        x = _mm256_add_pd(x, _mm256_mul_pd(b3, _mm256_loadu_pd(curves.x[3].data() + i)));
+        __m256d y = _mm256_add_pd(_mm256_mul_pd(b0, _mm256_loadu_pd(curves.y[0].data() + i)),
+                                  _mm256_mul_pd(b1, _mm256_loadu_pd(curves.y[1].data() + i)));
+        y = _mm256_add_pd(y, _mm256_mul_pd(b2, _mm256_loadu_pd(curves.y[2].data() + i)));
+        y = _mm256_add_pd(y, _mm256_mul_pd(b3, _mm256_loadu_pd(curves.y[3].data() + i)));
+        // (x0 y0 x2 y2), (x1 y1 x3 y3) -> (x0 y0 x1 y1), (x2 y2 x3 y3)
+        const __m256d low = _mm256_unpacklo_pd(x, y);
+        const __m256d high = _mm256_unpackhi_pd(x, y);
+        auto* out = reinterpret_cast<double*>(row + i);
+        _mm256_storeu_pd(out, _mm256_permute2f128_pd(low, high, 0x20));
+        _mm256_storeu_pd(out + 4, _mm256_permute2f128_pd(low, high, 0x31));
+    }
+}
+#endif
+
+#if defined(PLANE_GEOMETRY_HAS_SSE2)
+inline void evaluateCubicBlocksSse2(const CubicBezierBatch<double>& curves,
+                                    const std::array<double, 4>& weights,
+                                    std::size_t begin,
+                                    std::size_t end,
+                                    Point2D<double>* row) {
+    const __m128d b0 = _mm_set1_pd(weights[0]);
+    const __m128d b1 = _mm_set1_pd(weights[1]);
+    const __m128d b2 = _mm_set1_pd(weights[2]);
+    const __m128d b3 = _mm_set1_pd(weights[3]);
+    for (std::size_t i = begin; i < end; i += 2) {
+        __m128d x = _mm_add_pd(_mm_mul_pd(b0, _mm_loadu_pd(curves.x[0].data() + i)),
+                               _mm_mul_pd(b1, _mm_loadu_pd(curves.x[1].data() + i)));
+        x = _mm_add_pd(x, _mm_mul_pd(b2, _mm_loadu_pd(curves.x[2].data() + i)));
+        x = _mm_add_pd(x, _mm_mul_pd(b3, _mm_loadu_pd(curves.x[3].data() + i)));
+        __m128d y = _mm_add_pd(_mm_mul_pd(b0, _mm_loadu_pd(curves.y[0].data() + i)),
+                               _mm_mul_pd(b1, _mm_loadu_pd(curves.y[1].data() + i)));
+        y = _mm_add_pd(y, _mm_mul_pd(b2, _mm_loadu_pd(curves.y[2].data() + i)));
+        y = _mm_add_pd(y, _mm_mul_pd(b3, _mm_loadu_pd(curves.y[3].data() + i)));
+        auto* out = reinterpret_cast<double*>(row + i);
+        _mm_storeu_pd(out, _mm_unpacklo_pd(x, y));
+        _mm_storeu_pd(out + 2, _mm_unpackhi_pd(x, y));
+    }
+}
+#endif
+
+// Runs the widest available kernel over tiles of curves, every parameter per tile, so a tile's
+// control points stay in cache and each result row is written contiguously. Returns how many
+// curves it covered; the rest are left to the scalar loop.
+inline std::size_t evaluateBezierCubicBatchVector(const CubicBezierBatch<double>& curves,
+                                                  const std::vector<std::array<double, 4>>& basis,
+                                                  std::vector<Point2D<double>>& result) {
+    using BlockKernel = void (*)(const CubicBezierBatch<double>&, const std::array<double, 4>&, std::size_t,
+                                 std::size_t, Point2D<double>*);
+    BlockKernel blockKernel = nullptr;
+    std::size_t lanes = 1;
+#if defined(PLANE_GEOMETRY_HAS_AVX2)
+    if (cpuHasAvx2()) {
+        blockKernel = evaluateCubicBlocksAvx2;
+        lanes = 4;
+    }
+#endif
+#if defined(PLANE_GEOMETRY_HAS_SSE2)
+    if (blockKernel == nullptr) {
+        blockKernel = evaluateCubicBlocksSse2;
+        lanes = 2;
+    }
+#endif
+    if (blockKernel == nullptr) {
+        return 0;
+    }
+
+    constexpr std::size_t TileSize = 512;
+    const std::size_t curveCount = curves.size();
+    const std::size_t covered = curveCount - curveCount % lanes;
+    for (std::size_t begin = 0; begin < covered; begin += TileSize) {
+        const std::size_t end = std::min(begin + TileSize, covered);
+        for (std::size_t j = 0; j < basis.size(); ++j) {
+            blockKernel(curves, basis[j], begin, end, result.data() + j * curveCount);
+        }
+    }
+    return covered;
+}
+
+// Part of a Bezier curve for intersection: its own control points and the interval of the
+// original curve's parameter they cover.
+template <typename Scalar>
+struct BezierPiece {
+    std::vector<Point2D<Scalar>> points;
+    Scalar from;
+    Scalar to;
+};
+
+// Splits the control polygon at t into the pieces over [0, t] and [t, 1].
+template <typename Scalar>
+void splitBezier(const std::vector<Point2D<Scalar>>& points,
+                 const Scalar& t,
+                 std::vector<Point2D<Scalar>>& left,
+                 std::vector<Point2D<Scalar>>& right) {
+    const std::size_t width = points.size();
+    std::vector<Point2D<Scalar>> work(points);
+    left.resize(width);
+    right.resize(width);
+    left.front() = work.front();
+    right.back() = work.back();
+    const Scalar oneMinusT = Scalar{1} - t;
+    for (std::size_t level = 1; level < width; ++level) {
+        for (std::size_t i = 0; i + level < width; ++i) {
+            work[i] = {oneMinusT * work[i].x + t * work[i + 1].x, oneMinusT * work[i].y + t * work[i + 1].y};
+        }
+        left[level] = work.front();
+        right[width - 1 - level] = work[width - 1 - level];
+    }
+}
+
+// The piece restricted to [lo, hi] of its own parameter.
+template <typename Scalar>
+BezierPiece<Scalar> restrictBezier(const BezierPiece<Scalar>& piece, const Scalar& lo, const Scalar& hi) {
+    std::vector<Point2D<Scalar>> head;
+    std::vector<Point2D<Scalar>> tail;
+    splitBezier(piece.points, hi, head, tail);
+    if (hi > Scalar{}) {
+        splitBezier(head, Scalar(lo / hi), tail, head);
+    }
+    const Scalar span = piece.to - piece.from;
+    return {std::move(head), piece.from + span * lo, piece.from + span * hi};
+}
+
+template <typename Scalar>
+std::array<Point2D<Scalar>, 2> controlBounds(const std::vector<Point2D<Scalar>>& points) {
+    std::array<Point2D<Scalar>, 2> bounds{points.front(), points.front()};
+    for (const auto& point : points) {
+        bounds[0] = {std::min(bounds[0].x, point.x), std::min(bounds[0].y, point.y)};
+        bounds[1] = {std::max(bounds[1].x, point.x), std::max(bounds[1].y, point.y)};
+    }
+    return bounds;
+}
+
+// Narrows [lo, hi] (initially [0, 1]) to the parameters of piece whose control polygon's convex
+// hull lies in the fat line of other: the strip along other's chord containing all of other's
+// control points, widened by eps. Returns false when nothing of piece is left.
+template <typename Scalar>
+bool clipToFatLine(const std::vector<Point2D<Scalar>>& piece,
+                   const std::vector<Point2D<Scalar>>& other,
+                   const Scalar& eps,
+                   Scalar& lo,
+                   Scalar& hi) {
+    lo = Scalar{};
+    hi = Scalar{1};
+    const auto& origin = other.front();
+    const Point2D<Scalar> normal{origin.y - other.back().y, other.back().x - origin.x};
+    const Scalar length = sqrtValue(squaredLength(normal));
+    if (!(length > eps)) {
+        return true;
+    }
+    // Distances are scaled by the chord length throughout.
+    Scalar low{};
+    Scalar high{};
+    for (const auto& point : other) {
+        const Scalar distance = dot(normal, subtract(point, origin));
+        low = std::min(low, distance);
+        high = std::max(high, distance);
+    }
+    low -= eps * length;
+    high += eps * length;
+
+    const std::size_t degree = piece.size() - 1;
+    std::vector<Scalar> distances(piece.size());
+    for (std::size_t i = 0; i <= degree; ++i) {
+        distances[i] = dot(normal, subtract(piece[i], origin));
+    }
+    const auto parameter = [degree](std::size_t i) {
+        return static_cast<Scalar>(i) / static_cast<Scalar>(degree);
+    };
+
+    // The hull's part inside the strip spans from its leftmost to its rightmost point, each a
+    // control point inside the strip or a crossing of a strip boundary by a pair of them.
+    Scalar first{2};
+    Scalar last{-1};
+    const auto include = [&](const Scalar& t) {
+        first = std::min(first, t);
+        last = std::max(last, t);
+    };
+    for (std::size_t i = 0; i <= degree; ++i) {
+        if (!(distances[i] < low) && !(distances[i] > high)) {
+            include(parameter(i));
+        }
+        for (std::size_t j = i + 1; j <= degree; ++j) {
+            for (const Scalar* boundary : {&low, &high}) {
+                const Scalar di = distances[i] - *boundary;
+                const Scalar dj = distances[j] - *boundary;
+                if ((di < Scalar{} && dj > Scalar{}) || (di > Scalar{} && dj < Scalar{})) {
+                    include(parameter(i) + (parameter(j) - parameter(i)) * di / (di - dj));
+                }
+            }
+        }
+    }
+    if (first > last) {
+        return false;
+    }
+    lo = std::max(first, Scalar{});
+    hi = std::min(last, Scalar{1});
+    return true;
+}
+
+// Bezier clipping (Sederberg and Nishita): each step clips one curve to the fat line of the
+// other and swaps roles; a step that keeps more than 80% of the interval halves the larger
+// piece instead, which also separates multiple intersections. Pieces whose control boxes are
+// apart by more than eps are dropped, and a pair of pieces both within eps is an intersection.
+template <typename Scalar>
+std::vector<BezierIntersection<Scalar>> clipBezierCurves(const std::vector<Point2D<Scalar>>& first,
+                                                         const std::vector<Point2D<Scalar>>& second,
+                                                         const Scalar& eps) {
+    struct Pending {
+        BezierPiece<Scalar> clipped;
+        BezierPiece<Scalar> against;
+        bool swapped;
+        unsigned depth;
+    };
+    // Curves that overlap along a stretch never separate; the caps stop them after reporting
+    // points along the overlap.
+    constexpr unsigned MaxDepth = 128;
+    constexpr std::size_t MaxSteps = std::size_t{1} << 16;
+    const Scalar minimumShrink{0.8};
+
+    std::vector<BezierIntersection<Scalar>> found;
+    std::vector<Pending> stack;
+    stack.push_back({{first, Scalar{}, Scalar{1}}, {second, Scalar{}, Scalar{1}}, false, 0});
+    for (std::size_t step = 0; !stack.empty() && step < MaxSteps; ++step) {
+        Pending pending = std::move(stack.back());
+        stack.pop_back();
+
+        const auto boundsA = controlBounds(pending.clipped.points);
+        const auto boundsB = controlBounds(pending.against.points);
+        if (boundsA[0].x > boundsB[1].x + eps || boundsB[0].x > boundsA[1].x + eps ||
+            boundsA[0].y > boundsB[1].y + eps || boundsB[0].y > boundsA[1].y + eps) {
+            continue;
+        }
+        const Scalar extentA = std::max(boundsA[1].x - boundsA[0].x, boundsA[1].y - boundsA[0].y);
+        const Scalar extentB = std::max(boundsB[1].x - boundsB[0].x, boundsB[1].y - boundsB[0].y);
+        if ((extentA <= eps && extentB <= eps) || pending.depth >= MaxDepth) {
+            const auto& onFirst = pending.swapped ? pending.against : pending.clipped;
+            const auto& onSecond = pending.swapped ? pending.clipped : pending.against;
+            const Scalar half{0.5};
+            const Scalar t = half * (onFirst.from + onFirst.to);
+            found.push_back({t, half * (onSecond.from + onSecond.to), evaluateBezierInline(first, t)});
+            continue;
+        }
+
+        Scalar lo;
+        Scalar hi;
+        if (!clipToFatLine(pending.clipped.points, pending.against.points, eps, lo, hi)) {
+            continue;
+        }
+        if (hi - lo > minimumShrink) {
+            auto& larger = extentA >= extentB ? pending.clipped : pending.against;
+            const Scalar half{0.5};
+            BezierPiece<Scalar> low{{}, larger.from, half * (larger.from + larger.to)};
+            BezierPiece<Scalar> high{{}, low.to, larger.to};
+            splitBezier(larger.points, half, low.points, high.points);
+            Pending other = pending;
+            (extentA >= extentB ? other.clipped : other.against) = std::move(high);
+            larger = std::move(low);
+            ++pending.depth;
+            ++other.depth;
+            stack.push_back(std::move(other));
+            stack.push_back(std::move(pending));
+            continue;
+        }
+        stack.push_back({std::move(pending.against),
+                         restrictBezier(pending.clipped, lo, hi),
+                         !pending.swapped,
+                         pending.depth + 1});
+    }
+
+    std::sort(found.begin(), found.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.firstParameter < rhs.firstParameter;
+    });
+    // A crossing can be found from several neighbouring pieces and a tangency from a whole run
+    // of them; each chain of hits spaced closer than mergeDistance is reported by its middle.
+    std::vector<BezierIntersection<Scalar>> merged;
+    const Scalar mergeDistance = Scalar{16} * eps;
+    for (std::size_t i = 0; i < found.size();) {
+        std::size_t j = i + 1;
+        while (j < found.size() && pointsEqual(found[j - 1].point, found[j].point, mergeDistance)) {
+            ++j;
+        }
+        merged.push_back(found[i + (j - i) / 2]);
+        i = j;
+    }
+    return merged;
+}
+
+template <typename Scalar, std::size_t N>
+void sampleBezierCurve(const BezierCurve<Scalar, N>& curve,
+                       std::size_t sampleCount,
+                       std::vector<Point2D<Scalar>>& samples) {
+    if (sampleCount == 1) {
+        samples.push_back(curve.evaluate(Scalar{}));
+        return;
+    }
+    for (std::size_t i = 0; i < sampleCount; ++i) {
+        const Scalar t = static_cast<Scalar>(i) / static_cast<Scalar>(sampleCount - 1);
+        samples.push_back(curve.evaluate(t));
     }
-    return det < -Scalar{Epsilon};
 }
 
 }  // namespace detail
@@ -573,7 +4911,23 @@ Point2D<Scalar> polygonCentroidFromBoundary(const std::vector<Point2D<Scalar>>&
 template <typename Scalar>
 Orientation classifyPointRelativeToSegment(const Segment2D<Scalar>& segment,
                                            const Point2D<Scalar>& point,
-                                           const Scalar& epsilon) {
+                                           const Scalar& epsilon,
+                                           PredicateKernel kernel) {
+    if (kernel == PredicateKernel::Filtered) {
+        if (detail::pointsIdentical(segment.start, segment.end)) {
+            return detail::pointsIdentical(point, segment.start) ? Orientation::OnSegment : Orientation::Right;
+        }
+        const int sign = detail::filteredOrientationSign(segment.start, segment.end, point);
+        if (sign != 0) {
+            return sign > 0 ? Orientation::Left : Orientation::Right;
+        }
+        const int position = detail::collinearPosition(segment.start, segment.end, point);
+        if (position == 0) {
+            return Orientation::OnSegment;
+        }
+        return position < 0 ? Orientation::Right : Orientation::Left;
+    }
+
     const auto ab = detail::subtract(segment.end, segment.start);
     const auto ap = detail::subtract(point, segment.start);
     const Scalar abLengthSquared = detail::squaredLength(ab);
@@ -599,7 +4953,12 @@ Orientation classifyPointRelativeToSegment(const Segment2D<Scalar>& segment,
 template <typename Scalar>
 SegmentIntersectionResult<Scalar> intersectSegments(const Segment2D<Scalar>& first,
                                                     const Segment2D<Scalar>& second,
-                                                    const Scalar& epsilon) {
+                                                    const Scalar& epsilon,
+                                                    PredicateKernel kernel) {
+    if (kernel == PredicateKernel::Filtered) {
+        return detail::intersectSegmentsFiltered(first, second);
+    }
+
     SegmentIntersectionResult<Scalar> result{};
 
     const auto p = first.start;
@@ -695,513 +5054,387 @@ SegmentIntersectionResult<Scalar> intersectSegments(const Segment2D<Scalar>& fir
 }
 
 template <typename Scalar>
-std::vector<Point2D<Scalar>> computeConvexHull(const std::vector<Point2D<Scalar>>& points) {
-    return detail::convexHullFromPoints(points, defaultEpsilon<Scalar>());
+std::vector<SegmentPairIntersection<Scalar>> intersectAllSegments(const std::vector<Segment2D<Scalar>>& segments,
+                                                                  const Scalar& epsilon,
+                                                                  PredicateKernel kernel) {
+    if (segments.size() >= detail::NoIndex - 1) {
+        throw std::invalid_argument("intersectAllSegments: too many segments");
+    }
+    if (kernel == PredicateKernel::Tolerance && !segments.empty()) {
+        return detail::intersectAllSegmentsTolerance(segments, epsilon);
+    }
+    const auto candidates = detail::SegmentSweep<Scalar>(segments, epsilon, kernel).run();
+    std::vector<SegmentPairIntersection<Scalar>> intersections;
+    intersections.reserve(candidates.size());
+    for (const auto& candidate : candidates) {
+        const auto result = intersectSegments(segments[candidate.first], segments[candidate.second], epsilon, kernel);
+        if (result.type != IntersectionType::None) {
+            intersections.push_back({candidate.first, candidate.second, result});
+        }
+    }
+    return intersections;
+}
+
+template <typename Scalar>
+std::vector<Point2D<Scalar>> computeConvexHull(const std::vector<Point2D<Scalar>>& points,
+                                               PredicateKernel kernel) {
+    return detail::convexHullFromPoints(points, defaultEpsilon<Scalar>(), kernel);
+}
+
+template <typename Scalar>
+std::vector<Triangle2D<Scalar>> delaunayTriangulation(const std::vector<Point2D<Scalar>>& points,
+                                                      PredicateKernel kernel) {
+    return delaunayTriangulation(points, DelaunayOptions{kernel, std::nullopt});
 }
 
 template <typename Scalar>
-std::vector<Triangle2D<Scalar>> delaunayTriangulation(const std::vector<Point2D<Scalar>>& points) {
+TriangleMesh<Scalar> delaunayTriangulationMesh(const std::vector<Point2D<Scalar>>& points,
+                                               const DelaunayOptions& options) {
+    const PredicateKernel kernel = options.kernel;
+    TriangleMesh<Scalar> mesh;
     if (points.size() < 3) {
-        return {};
+        return mesh;
     }
 
+    // Sorted in exact order, which unlike lexLess is a strict weak ordering. Under the tolerance
+    // kernel points within epsilon are then welded onto the first of them in that order, so no
+    // two vertices are closer than the predicates can tell apart.
     std::vector<Point2D<Scalar>> uniquePoints = points;
-    std::sort(uniquePoints.begin(), uniquePoints.end(), [](const auto& lhs, const auto& rhs) {
-        if (detail::lexLess(lhs, rhs)) {
-            return true;
+    std::sort(uniquePoints.begin(), uniquePoints.end(),
+              [](const auto& lhs, const auto& rhs) { return detail::lexLessExact(lhs, rhs); });
+    uniquePoints.erase(std::unique(uniquePoints.begin(), uniquePoints.end(),
+                                   [](const auto& lhs, const auto& rhs) { return detail::pointsIdentical(lhs, rhs); }),
+                       uniquePoints.end());
+    if (kernel != PredicateKernel::Filtered) {
+        detail::VertexWelder<Scalar> welder(defaultEpsilon<Scalar>(), uniquePoints.size());
+        for (const auto& point : uniquePoints) {
+            welder.weld(point);
         }
-        if (detail::lexLess(rhs, lhs)) {
-            return false;
-        }
-        return false;
-    });
-    uniquePoints.erase(std::unique(uniquePoints.begin(), uniquePoints.end(), [](const auto& lhs, const auto& rhs) {
-                       return detail::pointsEqual(lhs, rhs);
-                   }),
-                   uniquePoints.end());
+        uniquePoints = welder.points();
+    }
 
     if (uniquePoints.size() < 3) {
-        return {};
+        return mesh;
     }
 
-    std::mt19937 generator{std::random_device{}()};
-    std::shuffle(uniquePoints.begin(), uniquePoints.end(), generator);
-
-    const auto superTriangle = detail::makeSuperTriangle(uniquePoints);
-
-    std::vector<Triangle2D<Scalar>> triangulation;
-    triangulation.push_back({superTriangle[0], superTriangle[1], superTriangle[2]});
-
-    for (const auto& point : uniquePoints) {
-        std::vector<Triangle2D<Scalar>> badTriangles;
-        std::vector<Triangle2D<Scalar>> goodTriangles;
-        badTriangles.reserve(triangulation.size());
-        goodTriangles.reserve(triangulation.size());
-
-        for (const auto& triangle : triangulation) {
-            if (detail::isPointInsideCircumcircle(triangle, point)) {
-                badTriangles.push_back(triangle);
-            } else {
-                goodTriangles.push_back(triangle);
-            }
-        }
-
-        std::map<detail::EdgeKey<Scalar>, int> edgeCounter;
-        for (const auto& triangle : badTriangles) {
-            edgeCounter[detail::makeEdge(triangle.a, triangle.b)]++;
-            edgeCounter[detail::makeEdge(triangle.b, triangle.c)]++;
-            edgeCounter[detail::makeEdge(triangle.c, triangle.a)]++;
-        }
-
-        triangulation = std::move(goodTriangles);
-
-        for (const auto& [edge, count] : edgeCounter) {
-            if (count != 1) {
-                continue;
-            }
-            Triangle2D<Scalar> newTriangle{edge.u, edge.v, point};
-            if (detail::orientationDet(newTriangle.a, newTriangle.b, newTriangle.c) < Scalar{}) {
-                std::swap(newTriangle.b, newTriangle.c);
-            }
-            triangulation.push_back(newTriangle);
-        }
+    if (uniquePoints.size() >= detail::GhostVertex) {
+        throw std::invalid_argument("delaunayTriangulation: too many points");
     }
 
-    const auto isSuperVertex = [&](const Point2D<Scalar>& vertex) {
-        return detail::pointsEqual(vertex, superTriangle[0]) ||
-               detail::pointsEqual(vertex, superTriangle[1]) ||
-               detail::pointsEqual(vertex, superTriangle[2]);
-    };
-
-    triangulation.erase(std::remove_if(triangulation.begin(), triangulation.end(),
-                                       [&](const Triangle2D<Scalar>& triangle) {
-                                           return isSuperVertex(triangle.a) ||
-                                                  isSuperVertex(triangle.b) ||
-                                                  isSuperVertex(triangle.c);
-                                       }),
-                        triangulation.end());
+    if (options.parallel) {
+        const unsigned threadCount = options.threadCount > 0 ? options.threadCount
+                                                             : std::max(1u, std::thread::hardware_concurrency());
+        detail::DivideAndConquerDelaunay<Scalar> triangulation(uniquePoints);
+        triangulation.build(threadCount);
+        triangulation.exportTopology(mesh);
+        mesh.vertices = std::move(uniquePoints);
+        return mesh;
+    }
 
-    return triangulation;
+    std::mt19937 generator{options.seed ? *options.seed : std::random_device{}()};
+    detail::Triangulation<Scalar> triangulation(std::move(uniquePoints), kernel, generator());
+    if (triangulation.build(detail::brioOrder(triangulation.approximatePoints(), generator), true)) {
+        triangulation.exportTopology(mesh);
+    }
+    mesh.vertices = std::move(triangulation.points());
+    return mesh;
 }
 
 template <typename Scalar>
-Polygon<Scalar> intersectConvexPolygons(const Polygon<Scalar>& polyA,
-                                        const Polygon<Scalar>& polyB,
-                                        const Scalar& epsilon) {
-    Polygon<Scalar> normalizedA = detail::normalizePolygon(polyA, epsilon);
-    Polygon<Scalar> normalizedB = detail::normalizePolygon(polyB, epsilon);
-
-    if (normalizedA.empty() || normalizedB.empty()) {
-        return {};
+std::vector<Triangle2D<Scalar>> delaunayTriangulation(const std::vector<Point2D<Scalar>>& points,
+                                                      const DelaunayOptions& options) {
+    const TriangleMesh<Scalar> mesh = delaunayTriangulationMesh(points, options);
+    std::vector<Triangle2D<Scalar>> triangles;
+    triangles.reserve(mesh.triangles.size());
+    for (const auto& triangle : mesh.triangles) {
+        triangles.push_back({mesh.vertices[triangle[0]], mesh.vertices[triangle[1]], mesh.vertices[triangle[2]]});
     }
+    return triangles;
+}
 
-    std::vector<Point2D<Scalar>> candidates;
-    candidates.reserve(normalizedA.size() + normalizedB.size());
-
-    for (const auto& point : normalizedA) {
-        if (detail::polygonContainsPoint(normalizedB, point, epsilon)) {
-            detail::appendUniquePoint(candidates, point, epsilon);
-        }
+template <typename Scalar>
+TriangleMesh<Scalar> constrainedDelaunayTriangulation(const std::vector<Point2D<Scalar>>& points,
+                                                      const std::vector<std::array<std::uint32_t, 2>>& constraints,
+                                                      PredicateKernel kernel) {
+    TriangleMesh<Scalar> mesh;
+    if (points.size() >= detail::GhostVertex) {
+        throw std::invalid_argument("constrainedDelaunayTriangulation: too many points");
     }
-    for (const auto& point : normalizedB) {
-        if (detail::polygonContainsPoint(normalizedA, point, epsilon)) {
-            detail::appendUniquePoint(candidates, point, epsilon);
+    for (const auto& constraint : constraints) {
+        if (constraint[0] >= points.size() || constraint[1] >= points.size()) {
+            throw std::invalid_argument("constrainedDelaunayTriangulation: constraint index out of range");
         }
     }
 
-    const auto intersections = detail::collectIntersections(normalizedA, normalizedB, epsilon);
-    for (const auto& info : intersections) {
-        detail::appendUniquePoint(candidates, info.point, epsilon);
+    detail::Triangulation<Scalar> triangulation(points, kernel, detail::DefaultTriangulationSeed);
+    if (detail::buildConstrainedTriangulation(triangulation, constraints)) {
+        triangulation.exportTopology(mesh);
     }
-
-    if (candidates.size() < 3) {
-        return {};
-    }
-
-    auto hull = detail::convexHullFromPoints(std::move(candidates), epsilon);
-    return detail::cleanupPolygon(hull, epsilon);
+    mesh.vertices = std::move(triangulation.points());
+    return mesh;
 }
 
 template <typename Scalar>
-std::vector<Polygon<Scalar>> buildLoopsFromSegments(
-    const std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>>& segments,
-    const Scalar& epsilon)
-{
-    if (segments.empty()) return {};
+DynamicDelaunayTriangulation<Scalar>::DynamicDelaunayTriangulation(PredicateKernel kernel)
+    : m_kernel(kernel),
+      m_triangulation(std::make_unique<detail::Triangulation<Scalar>>(std::vector<Point2D<Scalar>>{}, kernel,
+                                                                      std::random_device{}())) {}
 
-    std::vector<Point2D<Scalar>> uniquePoints;
-    uniquePoints.reserve(segments.size() * 2);
-    std::vector<std::vector<std::size_t>> adjacency;
-
-    struct SegmentRecord {
-        std::size_t start{};
-        std::size_t end{};
-        double angle{};
-        bool used{false};
-    };
-
-    constexpr double TwoPi = 6.283185307179586476925286766559005768394;
-    constexpr double AngleEps = 1e-12;
-
-    auto toDouble = [](const Scalar& v) -> double { return static_cast<double>(v); };
-
-    std::vector<SegmentRecord> records;
-    records.reserve(segments.size());
-
-    auto indexOf = [&](const Point2D<Scalar>& p) -> std::size_t {
-        for (std::size_t i = 0; i < uniquePoints.size(); ++i)
-            if (detail::pointsEqual(uniquePoints[i], p, epsilon)) return i;
-        uniquePoints.push_back(p);
-        adjacency.resize(uniquePoints.size());
-        return uniquePoints.size() - 1;
-    };
+template <typename Scalar>
+DynamicDelaunayTriangulation<Scalar>::~DynamicDelaunayTriangulation() = default;
 
-    for (const auto& seg : segments) {
-        if (detail::pointsEqual(seg.first, seg.second, epsilon)) continue;
-        const std::size_t s = indexOf(seg.first);
-        const std::size_t e = indexOf(seg.second);
-        const auto dir = detail::subtract(uniquePoints[e], uniquePoints[s]);
-        double angle = std::atan2(toDouble(dir.y), toDouble(dir.x));
-        if (angle < 0.0) angle += TwoPi;
-        records.push_back({s, e, angle, false});
-        adjacency[s].push_back(records.size() - 1);
-    }
+template <typename Scalar>
+DynamicDelaunayTriangulation<Scalar>::DynamicDelaunayTriangulation(DynamicDelaunayTriangulation&& other) noexcept = default;
 
-    if (records.empty()) return {};
+template <typename Scalar>
+DynamicDelaunayTriangulation<Scalar>&
+DynamicDelaunayTriangulation<Scalar>::operator=(DynamicDelaunayTriangulation&& other) noexcept = default;
 
-    for (auto& neigh : adjacency) {
-        std::sort(neigh.begin(), neigh.end(),
-                  [&](std::size_t L, std::size_t R){ return records[L].angle < records[R].angle; });
+template <typename Scalar>
+std::uint32_t DynamicDelaunayTriangulation<Scalar>::insert(const Point2D<Scalar>& point) {
+    const std::uint32_t vertex = m_triangulation->addVertex(point);
+    if (!m_triangulation->insert(vertex)) {
+        m_triangulation->releaseVertex(vertex);
+        return InvalidVertex;
     }
+    return vertex;
+}
 
-    std::vector<Polygon<Scalar>> loops;
-
-    for (std::size_t i = 0; i < records.size(); ++i) {
-        if (records[i].used) continue;
-
-        Polygon<Scalar> loop;
-        std::vector<std::size_t> path;
-        std::size_t cur = i;
-        double prevAngle = records[cur].angle;
-        bool closed = false;
-
-        while (true) {
-            auto& rec = records[cur];
-            rec.used = true;
-            path.push_back(cur);
-
-            const auto& sP = uniquePoints[rec.start];
-            const auto& eP = uniquePoints[rec.end];
-
-            if (loop.empty() || !detail::pointsEqual(loop.back(), sP, epsilon)) loop.push_back(sP);
-            if (!detail::pointsEqual(loop.back(), eP, epsilon)) loop.push_back(eP);
-
-            if (detail::pointsEqual(eP, loop.front(), epsilon)) { closed = true; break; }
-
-            const auto& out = adjacency[rec.end];
-            std::size_t next = std::numeric_limits<std::size_t>::max();
-            double bestDelta = std::numeric_limits<double>::infinity();
-
-            for (const auto cand : out) {
-                if (records[cand].used) continue;
-                double delta = records[cand].angle - prevAngle;
-                while (delta <= AngleEps) delta += TwoPi;
-                if (delta < bestDelta) { bestDelta = delta; next = cand; }
-            }
-
-            if (next == std::numeric_limits<std::size_t>::max()) break;
-
-            prevAngle = records[next].angle;
-            cur = next;
-        }
-
-        if (!closed) {
-            for (const auto idx : path) records[idx].used = false;
-            continue;
-        }
-
-        if (loop.size() >= 3) {
-            loop = detail::cleanupPolygon(loop, epsilon);
-            if (!loop.empty()) loops.push_back(std::move(loop));
-        }
+template <typename Scalar>
+bool DynamicDelaunayTriangulation<Scalar>::remove(std::uint32_t vertex) {
+    if (!m_triangulation->isLive(vertex)) {
+        return false;
     }
-
-    return loops;
+    m_triangulation->remove(vertex);
+    m_triangulation->releaseVertex(vertex);
+    return true;
 }
 
 template <typename Scalar>
-Polygon<Scalar> buildPolygonFromSegments(const std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>>& segments,
-                                         const Scalar& epsilon) {
-    auto loops = buildLoopsFromSegments(segments, epsilon);
-    if (loops.empty()) return {};
-
-    Polygon<Scalar> best = loops.front();
-    Scalar bestArea = detail::absValue(detail::signedArea(best));
-    for (const auto& L : loops) {
-        const Scalar a = detail::absValue(detail::signedArea(L));
-        if (a > bestArea) { bestArea = a; best = L; }
+bool DynamicDelaunayTriangulation<Scalar>::move(std::uint32_t vertex, const Point2D<Scalar>& point) {
+    if (!m_triangulation->isLive(vertex)) {
+        return false;
     }
-    return detail::cleanupPolygon(best, epsilon);
+    return m_triangulation->relocate(vertex, point);
 }
 
 template <typename Scalar>
-BooleanResult<Scalar> unionConvexPolygons(const Polygon<Scalar>& polyA,
-                                    const Polygon<Scalar>& polyB,
-                                    const Scalar& epsilon) {
-    BooleanResult<Scalar> R;
-    Polygon<Scalar> normalizedA = detail::normalizePolygon(polyA, epsilon);
-    Polygon<Scalar> normalizedB = detail::normalizePolygon(polyB, epsilon);
+void DynamicDelaunayTriangulation<Scalar>::clear() {
+    m_triangulation = std::make_unique<detail::Triangulation<Scalar>>(std::vector<Point2D<Scalar>>{}, m_kernel,
+                                                                      std::random_device{}());
+}
 
-    if (normalizedA.empty() && normalizedB.empty()) return R;
-    if (normalizedA.empty()) {
-        R.outers.push_back(detail::cleanupPolygon(normalizedB, epsilon));
-        return R;
-    }
-    if (normalizedB.empty()) {
-        R.outers.push_back(detail::cleanupPolygon(normalizedA, epsilon));
-        return R;
-    }
-    if (detail::polygonContainsPolygon(normalizedA, normalizedB, epsilon)) {
-        R.outers.push_back(normalizedA);
-        return R;
-    }
-    if (detail::polygonContainsPolygon(normalizedB, normalizedA, epsilon)) {
-        R.outers.push_back(normalizedB);
-        return R;
-    }
-    if (detail::polygonsDoNotOverlap(normalizedA, normalizedB, epsilon)) {
-        R.outers.push_back(normalizedA);
-        R.outers.push_back(normalizedB);
-        return R;
-    }
+template <typename Scalar>
+std::size_t DynamicDelaunayTriangulation<Scalar>::vertexCount() const {
+    return m_triangulation->liveVertexCount();
+}
 
-    const auto intersections = detail::collectIntersections(normalizedA, normalizedB, epsilon);
+template <typename Scalar>
+TriangleMesh<Scalar> DynamicDelaunayTriangulation<Scalar>::mesh() const {
+    TriangleMesh<Scalar> result;
+    m_triangulation->exportTopology(result);
+    result.vertices = m_triangulation->points();
+    return result;
+}
 
-    auto buildSegments = [&](const Polygon<Scalar>& polygon, bool useFirst) {
-        std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>> segments;
-        if (polygon.empty()) {
-            return segments;
-        }
-        std::vector<std::vector<std::pair<Scalar, Point2D<Scalar>>>> edgePoints(polygon.size());
-        for (std::size_t i = 0; i < polygon.size(); ++i) {
-            edgePoints[i].push_back({Scalar{}, polygon[i]});
-            edgePoints[i].push_back({Scalar{1}, polygon[(i + 1) % polygon.size()]});
-        }
-        for (const auto& info : intersections) {
-            std::size_t edgeIndex = useFirst ? info.edgeIndexA : info.edgeIndexB;
-            if (edgeIndex >= polygon.size()) {
-                continue;
-            }
-            Scalar param = useFirst ? info.parameterA : info.parameterB;
-            if (param < Scalar{}) {
-                param = Scalar{};
-            }
-            if (param > Scalar{1}) {
-                param = Scalar{1};
-            }
-            edgePoints[edgeIndex].push_back({param, info.point});
+template <typename Scalar>
+TriangleMesh<Scalar> triangulateRegion(const BooleanResult<Scalar>& region, PredicateKernel kernel) {
+    std::vector<Point2D<Scalar>> points;
+    std::vector<std::array<std::uint32_t, 2>> constraints;
+    const auto addContour = [&](const Polygon<Scalar>& contour) {
+        if (contour.size() < 3) {
+            return;
         }
-        for (auto& edge : edgePoints) {
-            std::sort(edge.begin(), edge.end(), [](const auto& lhs, const auto& rhs) {
-                return lhs.first < rhs.first;
-            });
-            std::vector<std::pair<Scalar, Point2D<Scalar>>> unique;
-            for (const auto& entry : edge) {
-                if (!unique.empty() && detail::pointsEqual(unique.back().second, entry.second, epsilon)) {
-                    continue;
-                }
-                unique.push_back(entry);
-            }
-            for (std::size_t i = 0; i + 1 < unique.size(); ++i) {
-                const auto& start = unique[i].second;
-                const auto& end = unique[i + 1].second;
-                if (!detail::pointsEqual(start, end, epsilon)) {
-                    segments.emplace_back(start, end);
-                }
-            }
+        const auto first = static_cast<std::uint32_t>(points.size());
+        points.insert(points.end(), contour.begin(), contour.end());
+        const auto count = static_cast<std::uint32_t>(contour.size());
+        for (std::uint32_t i = 0; i < count; ++i) {
+            constraints.push_back({first + i, first + (i + 1) % count});
         }
-        return segments;
-    };
-
-    auto collectSegments = [&](const Polygon<Scalar>& first,
-                               const Polygon<Scalar>& second,
-                               bool useFirst,
-                               bool keepOutside) {
-        std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>> segments = buildSegments(first, useFirst);
-        std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>> output;
-        for (const auto& segment : segments) {
-            Point2D<Scalar> midpoint{(segment.first.x + segment.second.x) / Scalar{2},
-                                      (segment.first.y + segment.second.y) / Scalar{2}};
-            const bool inside = detail::polygonContainsPoint(second, midpoint, epsilon);
-            if ((keepOutside && !inside) || (!keepOutside && inside)) {
-                output.push_back(segment);
-            }
-        }
-        return output;
     };
-
-    std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>> boundarySegments;
-    auto outsideSegmentsA = collectSegments(normalizedA, normalizedB, true, true);
-    auto outsideSegmentsB = collectSegments(normalizedB, normalizedA, false, true);
-    boundarySegments.insert(boundarySegments.end(), outsideSegmentsA.begin(), outsideSegmentsA.end());
-    boundarySegments.insert(boundarySegments.end(), outsideSegmentsB.begin(), outsideSegmentsB.end());
-
-    std::map<detail::EdgeKey<Scalar>, int> cnt;
-    for (const auto& s : boundarySegments) {
-        cnt[detail::makeEdge(s.first, s.second)]++;
+    for (const auto& outer : region.outers) {
+        addContour(outer);
     }
-    std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>> filtered;
-    filtered.reserve(boundarySegments.size());
-    for (const auto& s : boundarySegments) {
-        if (cnt[detail::makeEdge(s.first, s.second)] == 1) {
-            filtered.push_back(s);
-        }
+    for (const auto& hole : region.holes) {
+        addContour(hole);
     }
-    boundarySegments.swap(filtered);
 
-    auto loops = buildLoopsFromSegments(boundarySegments, epsilon);
-    for (auto& L : loops) {
-        if (detail::signedArea(L) > Scalar{}) R.outers.push_back(std::move(L)); // только внешние
+    TriangleMesh<Scalar> mesh;
+    if (points.size() >= detail::GhostVertex) {
+        throw std::invalid_argument("triangulateRegion: too many points");
+    }
+    detail::Triangulation<Scalar> triangulation(points, kernel, detail::DefaultTriangulationSeed);
+    if (detail::buildConstrainedTriangulation(triangulation, constraints)) {
+        const std::vector<unsigned char> enclosed = triangulation.enclosedFaces();
+        triangulation.exportTopology(mesh, &enclosed);
     }
-    return R;
+    mesh.vertices = std::move(triangulation.points());
+    return mesh;
 }
 
 template <typename Scalar>
-BooleanResult<Scalar> differenceConvexPolygons(const Polygon<Scalar>& polyA,
-                                         const Polygon<Scalar>& polyB,
-                                         const Scalar& epsilon) {
-    BooleanResult<Scalar> R;
+Polygon<Scalar> intersectConvexPolygons(const Polygon<Scalar>& polyA,
+                                        const Polygon<Scalar>& polyB,
+                                        const Scalar& epsilon,
+                                        PredicateKernel kernel) {
     Polygon<Scalar> normalizedA = detail::normalizePolygon(polyA, epsilon);
     Polygon<Scalar> normalizedB = detail::normalizePolygon(polyB, epsilon);
 
-    if (normalizedA.empty()) {
-        return R;
-    }
-    if (normalizedB.empty()) {
-        R.outers.push_back(detail::cleanupPolygon(normalizedA, epsilon));
-        return R;
+    if (normalizedA.empty() || normalizedB.empty()) {
+        return {};
     }
-    if (detail::polygonContainsPolygon(normalizedB, normalizedA, epsilon)) {
-        return R;
+
+    auto boundary = detail::cleanupPolygon(
+        detail::chaseConvexIntersection(normalizedA, normalizedB, epsilon, kernel), epsilon, kernel);
+    if (boundary.size() >= 3) {
+        return boundary;
     }
-    if (detail::polygonContainsPolygon(normalizedA, normalizedB, epsilon)) {
-        R.outers.push_back(normalizedA);
-        auto Bh = normalizedB; std::reverse(Bh.begin(), Bh.end()); // CW для дыр
-        R.holes.push_back(std::move(Bh));
-        return R;
+
+    // Without a proper crossing the polygons are nested or their interiors are disjoint. An
+    // interior point of either one inside the other means nesting, and the smaller one is the
+    // intersection.
+    if (!detail::polygonContainsPoint(normalizedB, polygonCentroid(normalizedA), epsilon, kernel) &&
+        !detail::polygonContainsPoint(normalizedA, polygonCentroid(normalizedB), epsilon, kernel)) {
+        return {};
     }
-    if (detail::polygonsDoNotOverlap(normalizedA, normalizedB, epsilon)) {
-        R.outers.push_back(detail::cleanupPolygon(normalizedA, epsilon));
-        return R;
+    const bool smallerA = detail::signedArea(normalizedA) <= detail::signedArea(normalizedB);
+    return detail::cleanupPolygon(smallerA ? normalizedA : normalizedB, epsilon, kernel);
+}
+
+template <typename Scalar>
+BooleanResult<Scalar> unionConvexPolygons(const Polygon<Scalar>& polyA,
+                                    const Polygon<Scalar>& polyB,
+                                    const Scalar& epsilon,
+                                    PredicateKernel kernel) {
+    return BooleanOverlay<Scalar>(detail::normalizePolygon(polyA, epsilon), detail::normalizePolygon(polyB, epsilon),
+                                  epsilon, kernel)
+        .compute(BooleanOperation::Union);
+}
+
+template <typename Scalar>
+BooleanResult<Scalar> differenceConvexPolygons(const Polygon<Scalar>& polyA,
+                                         const Polygon<Scalar>& polyB,
+                                         const Scalar& epsilon,
+                                         PredicateKernel kernel) {
+    return BooleanOverlay<Scalar>(detail::normalizePolygon(polyA, epsilon), detail::normalizePolygon(polyB, epsilon),
+                                  epsilon, kernel)
+        .compute(BooleanOperation::Difference);
+}
+
+template <typename Scalar>
+BooleanOverlay<Scalar>::BooleanOverlay(const BooleanResult<Scalar>& regionA,
+                                       const BooleanResult<Scalar>& regionB,
+                                       const Scalar& epsilon,
+                                       PredicateKernel kernel)
+    : m_epsilon(epsilon),
+      m_kernel(kernel),
+      m_arrangement(std::make_unique<detail::Arrangement<Scalar>>()) {
+    std::vector<Segment2D<Scalar>> segments;
+    std::vector<unsigned> toggles;
+    detail::appendContourEdges(regionA, 1u, segments, toggles);
+    detail::appendContourEdges(regionB, 2u, segments, toggles);
+    if (segments.empty()) {
+        return;
     }
+    detail::buildArrangement(segments, toggles, epsilon, kernel, m_arrangement->vertices, m_arrangement->edges);
+    detail::ArrangementSweep<Scalar>(m_arrangement->vertices, m_arrangement->edges).run();
+}
 
-    const auto intersections = detail::collectIntersections(normalizedA, normalizedB, epsilon);
+template <typename Scalar>
+BooleanOverlay<Scalar>::BooleanOverlay(const Polygon<Scalar>& polyA,
+                                       const Polygon<Scalar>& polyB,
+                                       const Scalar& epsilon,
+                                       PredicateKernel kernel)
+    : BooleanOverlay(BooleanResult<Scalar>{{polyA}, {}}, BooleanResult<Scalar>{{polyB}, {}}, epsilon, kernel) {}
 
-    auto buildSegments = [&](const Polygon<Scalar>& polygon, bool useFirst) {
-        std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>> segments;
-        if (polygon.empty()) {
-            return segments;
-        }
-        std::vector<std::vector<std::pair<Scalar, Point2D<Scalar>>>> edgePoints(polygon.size());
-        for (std::size_t i = 0; i < polygon.size(); ++i) {
-            edgePoints[i].push_back({Scalar{}, polygon[i]});
-            edgePoints[i].push_back({Scalar{1}, polygon[(i + 1) % polygon.size()]});
-        }
-        for (const auto& info : intersections) {
-            std::size_t edgeIndex = useFirst ? info.edgeIndexA : info.edgeIndexB;
-            if (edgeIndex >= polygon.size()) {
-                continue;
-            }
-            Scalar param = useFirst ? info.parameterA : info.parameterB;
-            if (param < Scalar{}) {
-                param = Scalar{};
-            }
-            if (param > Scalar{1}) {
-                param = Scalar{1};
-            }
-            edgePoints[edgeIndex].push_back({param, info.point});
-        }
-        for (auto& edge : edgePoints) {
-            std::sort(edge.begin(), edge.end(), [](const auto& lhs, const auto& rhs) {
-                return lhs.first < rhs.first;
-            });
-            std::vector<std::pair<Scalar, Point2D<Scalar>>> unique;
-            for (const auto& entry : edge) {
-                if (!unique.empty() && detail::pointsEqual(unique.back().second, entry.second, epsilon)) {
-                    continue;
-                }
-                unique.push_back(entry);
-            }
-            for (std::size_t i = 0; i + 1 < unique.size(); ++i) {
-                const auto& start = unique[i].second;
-                const auto& end = unique[i + 1].second;
-                if (!detail::pointsEqual(start, end, epsilon)) {
-                    segments.emplace_back(start, end);
-                }
-            }
-        }
-        return segments;
-    };
+template <typename Scalar>
+BooleanOverlay<Scalar>::~BooleanOverlay() = default;
 
-    std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>> boundarySegments;
+template <typename Scalar>
+BooleanOverlay<Scalar>::BooleanOverlay(BooleanOverlay&& other) noexcept = default;
 
-    auto segmentsA = buildSegments(normalizedA, true);
-    for (const auto& segment : segmentsA) {
-        Point2D<Scalar> midpoint{(segment.first.x + segment.second.x) / Scalar{2},
-                                  (segment.first.y + segment.second.y) / Scalar{2}};
-        if (!detail::polygonContainsPoint(normalizedB, midpoint, epsilon)) {
-            boundarySegments.push_back(segment);
-        }
-    }
+template <typename Scalar>
+BooleanOverlay<Scalar>& BooleanOverlay<Scalar>::operator=(BooleanOverlay&& other) noexcept = default;
 
-    auto segmentsB = buildSegments(normalizedB, false);
-    for (const auto& segment : segmentsB) {
-        Point2D<Scalar> midpoint{(segment.first.x + segment.second.x) / Scalar{2},
-                                  (segment.first.y + segment.second.y) / Scalar{2}};
-        if (detail::polygonContainsPoint(normalizedA, midpoint, epsilon)) {
-            boundarySegments.emplace_back(segment.second, segment.first);
-        }
-    }
+template <typename Scalar>
+BooleanResult<Scalar> BooleanOverlay<Scalar>::compute(BooleanOperation operation) const {
+    return detail::traceBooleanContours(m_arrangement->vertices, m_arrangement->edges, operation, m_epsilon, m_kernel);
+}
 
-    std::map<detail::EdgeKey<Scalar>, int> cnt;
-    for (const auto& s : boundarySegments) {
-        cnt[detail::makeEdge(s.first, s.second)]++;
-    }
-    std::vector<std::pair<Point2D<Scalar>, Point2D<Scalar>>> filtered;
-    filtered.reserve(boundarySegments.size());
-    for (const auto& s : boundarySegments) {
-        if (cnt[detail::makeEdge(s.first, s.second)] == 1) {
-            filtered.push_back(s);
-        }
-    }
-    boundarySegments.swap(filtered);
-    
-    auto loops = buildLoopsFromSegments(boundarySegments, epsilon);
+template <typename Scalar>
+BooleanResult<Scalar> booleanOperation(const BooleanResult<Scalar>& regionA,
+                                       const BooleanResult<Scalar>& regionB,
+                                       BooleanOperation operation,
+                                       const Scalar& epsilon,
+                                       PredicateKernel kernel) {
+    return BooleanOverlay<Scalar>(regionA, regionB, epsilon, kernel).compute(operation);
+}
+
+template <typename Scalar>
+BooleanResult<Scalar> booleanOperation(const Polygon<Scalar>& polyA,
+                                       const Polygon<Scalar>& polyB,
+                                       BooleanOperation operation,
+                                       const Scalar& epsilon,
+                                       PredicateKernel kernel) {
+    return BooleanOverlay<Scalar>(polyA, polyB, epsilon, kernel).compute(operation);
+}
+
+template <typename Scalar>
+BooleanResult<Scalar> xorPolygons(const Polygon<Scalar>& polyA,
+                                  const Polygon<Scalar>& polyB,
+                                  const Scalar& epsilon,
+                                  PredicateKernel kernel) {
+    return booleanOperation(polyA, polyB, BooleanOperation::Xor, epsilon, kernel);
+}
 
-    // Разнести петли на внешние (CCW) и дырки (CW)
-    std::vector<Polygon<Scalar>> holes;
-    for (auto& L : loops) {
-        (detail::signedArea(L) > Scalar{}) ? R.outers.push_back(std::move(L))
-                                           : holes.push_back(std::move(L));
+template <typename Scalar>
+BooleanResult<Scalar> unionAll(const std::vector<Polygon<Scalar>>& polygons,
+                               const Scalar& epsilon,
+                               PredicateKernel kernel,
+                               unsigned threadCount) {
+    if (polygons.empty()) {
+        return {};
     }
 
-    // (опционально) привязать дырки к внешним по точке
-    for (auto& H : holes) {
-        for (auto& O : R.outers) {
-            if (detail::polygonContainsPoint(O, H.front(), epsilon)) {
-                R.holes.push_back(std::move(H));
-                break;
-            }
+    std::vector<std::array<double, 2>> centers;
+    centers.reserve(polygons.size());
+    for (const auto& polygon : polygons) {
+        double minX = std::numeric_limits<double>::max();
+        double minY = std::numeric_limits<double>::max();
+        double maxX = std::numeric_limits<double>::lowest();
+        double maxY = std::numeric_limits<double>::lowest();
+        for (const auto& point : polygon) {
+            const double x = detail::toDouble(point.x);
+            const double y = detail::toDouble(point.y);
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
         }
+        centers.push_back({0.5 * (minX + maxX), 0.5 * (minY + maxY)});
+    }
+    const std::vector<std::uint32_t> keys = detail::hilbertKeys(centers);
+    std::vector<std::uint32_t> order(polygons.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        order[i] = static_cast<std::uint32_t>(i);
     }
+    std::sort(order.begin(), order.end(), [&](std::uint32_t lhs, std::uint32_t rhs) {
+        return keys[lhs] != keys[rhs] ? keys[lhs] < keys[rhs] : lhs < rhs;
+    });
 
-    return R;
+    const unsigned threads = threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    unsigned depth = 0;
+    while ((1u << depth) < threads && depth < 16) {
+        ++depth;
+    }
+    return detail::cascadeUnion(polygons, order, 0, order.size(), epsilon, kernel, depth);
 }
 
 template <typename Scalar>
 PointClassification locatePointInConvexPolygon(const Polygon<Scalar>& polygon,
                                                const Point2D<Scalar>& point,
-                                               const Scalar& epsilon) {
+                                               const Scalar& epsilon,
+                                               PredicateKernel kernel) {
     const std::size_t vertexCount = polygon.size();
     if (vertexCount < 3) {
         throw std::invalid_argument("locatePointInConvexPolygon requires at least three vertices");
@@ -1212,20 +5445,14 @@ PointClassification locatePointInConvexPolygon(const Polygon<Scalar>& polygon,
         const auto& current = polygon[i];
         const auto& next = polygon[(i + 1) % vertexCount];
 
-        if (detail::pointOnSegment(point, current, next, epsilon)) {
+        if (detail::pointOnSegment(point, current, next, epsilon, kernel)) {
             return PointClassification::OnBoundary;
         }
 
-        const auto edge = detail::subtract(next, current);
-        const auto toPoint = detail::subtract(point, current);
-        const Scalar crossValue = detail::cross(edge, toPoint);
-        const Scalar tolerance = detail::crossTolerance(epsilon,
-                                                        detail::squaredLength(edge),
-                                                        detail::squaredLength(toPoint));
-        if (detail::absValue(crossValue) <= tolerance) {
+        const int currentSign = detail::edgeSide(current, next, point, epsilon, kernel);
+        if (currentSign == 0) {
             continue;
         }
-        const int currentSign = crossValue > Scalar{} ? 1 : -1;
         if (orientationSign == 0) {
             orientationSign = currentSign;
         } else if (orientationSign != currentSign) {
@@ -1236,16 +5463,86 @@ PointClassification locatePointInConvexPolygon(const Polygon<Scalar>& polygon,
     return PointClassification::Inside;
 }
 
+template <typename Scalar>
+ConvexPolygonLocator<Scalar>::ConvexPolygonLocator(Polygon<Scalar> polygon,
+                                                   const Scalar& epsilon,
+                                                   PredicateKernel kernel)
+    : m_polygon(std::move(polygon)),
+      m_epsilon(epsilon),
+      m_kernel(kernel) {
+    if (m_polygon.size() < 3) {
+        throw std::invalid_argument("ConvexPolygonLocator requires at least three vertices");
+    }
+    const Scalar area = detail::signedArea(m_polygon);
+    m_degenerate = area == Scalar{};
+    m_clockwise = area < Scalar{};
+}
+
+template <typename Scalar>
+PointClassification ConvexPolygonLocator<Scalar>::locate(const Point2D<Scalar>& point) const {
+    if (m_degenerate) {
+        return locatePointInConvexPolygon(m_polygon, point, m_epsilon, m_kernel);
+    }
+    const std::size_t n = m_polygon.size();
+    // The fan is walked counterclockwise, but each edge is tested in its input direction: the
+    // tolerance boundary and side tests are not symmetric in it.
+    const auto vertex = [&](std::size_t k) -> const Point2D<Scalar>& {
+        k %= n;
+        return m_clockwise ? m_polygon[(n - k) % n] : m_polygon[k];
+    };
+    const auto& pivot = m_polygon[0];
+    const auto onEdge = [&](std::size_t i) {
+        const auto& from = m_clockwise ? vertex(i + 1) : vertex(i);
+        const auto& to = m_clockwise ? vertex(i) : vertex(i + 1);
+        return detail::pointOnSegment(point, from, to, m_epsilon, m_kernel);
+    };
+    const auto outsideEdge = [&](std::size_t i) {
+        if (m_clockwise) {
+            return detail::edgeSide(vertex(i + 1), vertex(i), point, m_epsilon, m_kernel) > 0;
+        }
+        return detail::edgeSide(vertex(i), vertex(i + 1), point, m_epsilon, m_kernel) < 0;
+    };
+
+    // Wedge k lies between the rays through vertices k and k + 1; the exact search keeps the
+    // wedges consistent whatever the kernel.
+    std::size_t lo = 1;
+    std::size_t hi = n - 1;
+    if (detail::filteredOrientationSign(pivot, vertex(lo), point) < 0) {
+        hi = lo;
+    } else if (detail::filteredOrientationSign(pivot, vertex(hi), point) > 0) {
+        lo = hi - 1;
+    } else {
+        while (hi - lo > 1) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (detail::filteredOrientationSign(pivot, vertex(mid), point) >= 0) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+    }
+
+    // The edges around the wedge and the two through the pivot, which every wedge touches.
+    if (onEdge(0) || onEdge(n - 1) || onEdge(lo - 1) || onEdge(lo) || onEdge(lo + 1)) {
+        return PointClassification::OnBoundary;
+    }
+    if (outsideEdge(0) || outsideEdge(n - 1) || outsideEdge(lo)) {
+        return PointClassification::Outside;
+    }
+    return PointClassification::Inside;
+}
+
 template <typename Scalar>
 PointClassification locatePointInPolygon(const Polygon<Scalar>& polygon,
                                          const Point2D<Scalar>& point,
-                                         const Scalar& epsilon) {
+                                         const Scalar& epsilon,
+                                         PredicateKernel kernel) {
     if (polygon.size() < 3) {
         throw std::invalid_argument("locatePointInPolygon requires at least three vertices");
     }
 
     for (std::size_t i = 0; i < polygon.size(); ++i) {
-        if (detail::pointOnSegment(point, polygon[i], polygon[(i + 1) % polygon.size()], epsilon)) {
+        if (detail::pointOnSegment(point, polygon[i], polygon[(i + 1) % polygon.size()], epsilon, kernel)) {
             return PointClassification::OnBoundary;
         }
     }
@@ -1259,15 +5556,10 @@ PointClassification locatePointInPolygon(const Polygon<Scalar>& polygon,
         if (!upward && !downward) {
             continue;
         }
-        const auto edge = detail::subtract(next, current);
-        const auto toPoint = detail::subtract(point, current);
-        const Scalar crossValue = detail::cross(edge, toPoint);
-        const Scalar tolerance = detail::crossTolerance(epsilon,
-                                                        detail::squaredLength(edge),
-                                                        detail::squaredLength(toPoint));
-        if (upward && crossValue > tolerance) {
+        const int side = detail::edgeSide(current, next, point, epsilon, kernel);
+        if (upward && side > 0) {
             ++windingNumber;
-        } else if (downward && crossValue < -tolerance) {
+        } else if (downward && side < 0) {
             --windingNumber;
         }
     }
@@ -1275,6 +5567,252 @@ PointClassification locatePointInPolygon(const Polygon<Scalar>& polygon,
     return windingNumber == 0 ? PointClassification::Outside : PointClassification::Inside;
 }
 
+template <typename Scalar>
+std::vector<PointClassification> locatePointsInPolygon(const Polygon<Scalar>& polygon,
+                                                       const std::vector<Point2D<Scalar>>& points,
+                                                       const Scalar& epsilon,
+                                                       PredicateKernel kernel) {
+    if (polygon.size() < 3) {
+        throw std::invalid_argument("locatePointsInPolygon requires at least three vertices");
+    }
+
+    std::vector<PointClassification> result;
+    if constexpr (std::is_same_v<Scalar, double>) {
+        if (detail::locatePointsInPolygonBatch(polygon, points, epsilon, kernel, result)) {
+            return result;
+        }
+    }
+    result.reserve(points.size());
+    for (const auto& point : points) {
+        result.push_back(locatePointInPolygon(polygon, point, epsilon, kernel));
+    }
+    return result;
+}
+
+template <typename Scalar>
+PolygonLocator<Scalar>::PolygonLocator(Polygon<Scalar> polygon, const Scalar& epsilon, PredicateKernel kernel)
+    : m_polygon(std::move(polygon)),
+      m_epsilon(epsilon),
+      m_kernel(kernel) {
+    const std::size_t n = m_polygon.size();
+    if (n < 3) {
+        throw std::invalid_argument("PolygonLocator requires at least three vertices");
+    }
+    if (n >= detail::NoIndex / 4) {
+        throw std::invalid_argument("PolygonLocator: too many vertices");
+    }
+
+    // The interior is face 0 and lies left of counter-clockwise edges.
+    const bool counterClockwise = detail::signedArea(m_polygon) > Scalar{};
+    std::vector<SubdivisionEdge<Scalar>> edges;
+    edges.reserve(n);
+
+    // Under the tolerance kernel pointOnSegment accepts points up to epsilon * (length^2 + 1) /
+    // length off the edge's line and epsilon / length past its ends, or within epsilon of both
+    // coordinates of a shorter edge's start. Every box is widened by that reach.
+    std::vector<std::array<double, 4>> boxes(n);
+    m_order.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& current = m_polygon[i];
+        const auto& next = m_polygon[(i + 1) % n];
+        if (counterClockwise) {
+            edges.push_back({{current, next}, 0, SubdivisionEdge<Scalar>::NoFace});
+        } else {
+            edges.push_back({{current, next}, SubdivisionEdge<Scalar>::NoFace, 0});
+        }
+
+        Scalar reach{};
+        if (m_kernel == PredicateKernel::Tolerance) {
+            const Scalar lengthSquared = detail::squaredLength(detail::subtract(next, current));
+            reach = lengthSquared > m_epsilon * m_epsilon
+                        ? m_epsilon * (lengthSquared + Scalar{2}) / detail::sqrtValue(lengthSquared)
+                        : Scalar{2} * m_epsilon;
+        }
+        m_reach = std::max(m_reach, detail::toDouble(reach));
+        boxes[i] = {detail::toDouble(std::min(current.x, next.x) - reach),
+                    detail::toDouble(std::min(current.y, next.y) - reach),
+                    detail::toDouble(std::max(current.x, next.x) + reach),
+                    detail::toDouble(std::max(current.y, next.y) + reach)};
+        m_order[i] = static_cast<std::uint32_t>(i);
+    }
+    m_map = detail::buildTrapezoidDecomposition(edges, std::nullopt);
+
+    m_nodes.reserve(2 * n);
+    m_nodes.emplace_back();
+    buildNode(0, 0, static_cast<std::uint32_t>(n), boxes);
+}
+
+template <typename Scalar>
+PolygonLocator<Scalar>::~PolygonLocator() = default;
+
+template <typename Scalar>
+PolygonLocator<Scalar>::PolygonLocator(PolygonLocator&& other) noexcept = default;
+
+template <typename Scalar>
+PolygonLocator<Scalar>& PolygonLocator<Scalar>::operator=(PolygonLocator&& other) noexcept = default;
+
+template <typename Scalar>
+void PolygonLocator<Scalar>::buildNode(std::uint32_t node,
+                                       std::uint32_t first,
+                                       std::uint32_t last,
+                                       const std::vector<std::array<double, 4>>& boxes) {
+    constexpr std::uint32_t LeafSize = 4;
+    std::array<double, 4> box{std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                              -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    for (std::uint32_t slot = first; slot < last; ++slot) {
+        const auto& edge = boxes[m_order[slot]];
+        box = {std::min(box[0], edge[0]), std::min(box[1], edge[1]), std::max(box[2], edge[2]),
+               std::max(box[3], edge[3])};
+    }
+    m_nodes[node].box = box;
+    if (last - first <= LeafSize) {
+        m_nodes[node].first = first;
+        m_nodes[node].count = last - first;
+        return;
+    }
+
+    // Median split of the box centers along the wider side keeps the tree O(log n) deep.
+    const int axis = box[2] - box[0] >= box[3] - box[1] ? 0 : 1;
+    const std::uint32_t middle = first + (last - first) / 2;
+    std::nth_element(m_order.begin() + first, m_order.begin() + middle, m_order.begin() + last,
+                     [&](std::uint32_t lhs, std::uint32_t rhs) {
+                         return boxes[lhs][axis] + boxes[lhs][axis + 2] < boxes[rhs][axis] + boxes[rhs][axis + 2];
+                     });
+    const auto children = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes[node].first = children;
+    m_nodes.emplace_back();
+    m_nodes.emplace_back();
+    buildNode(children, first, middle, boxes);
+    buildNode(children + 1, middle, last, boxes);
+}
+
+template <typename Scalar>
+bool PolygonLocator<Scalar>::onBoundary(const Point2D<Scalar>& point) const {
+    const std::size_t n = m_polygon.size();
+    const double x = detail::toDouble(point.x);
+    const double y = detail::toDouble(point.y);
+
+    // The tree is at most 64 levels deep for any 32-bit edge count.
+    std::array<std::uint32_t, 64> stack;
+    std::size_t depth = 0;
+    stack[depth++] = 0;
+    while (depth > 0) {
+        const Node& node = m_nodes[stack[--depth]];
+        if (x < node.box[0] || y < node.box[1] || x > node.box[2] || y > node.box[3]) {
+            continue;
+        }
+        if (node.count == 0) {
+            stack[depth++] = node.first;
+            stack[depth++] = node.first + 1;
+            continue;
+        }
+        for (std::uint32_t slot = node.first; slot < node.first + node.count; ++slot) {
+            const std::uint32_t edge = m_order[slot];
+            if (detail::pointOnSegment(point, m_polygon[edge], m_polygon[(edge + 1) % n], m_epsilon, m_kernel)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename Scalar>
+PointClassification PolygonLocator<Scalar>::locate(const Point2D<Scalar>& point) const {
+    const std::uint32_t trapezoid = m_map->find(point).trapezoid;
+    if (!m_map->holdsDisk(trapezoid, point, m_reach) && onBoundary(point)) {
+        return PointClassification::OnBoundary;
+    }
+    return m_map->face(trapezoid) == 0 ? PointClassification::Inside : PointClassification::Outside;
+}
+
+template <typename Scalar>
+TrapezoidalMap<Scalar>::TrapezoidalMap(const std::vector<SubdivisionEdge<Scalar>>& edges,
+                                       std::optional<std::uint32_t> seed)
+    : m_map(detail::buildTrapezoidDecomposition(edges, seed)) {}
+
+template <typename Scalar>
+TrapezoidalMap<Scalar>::TrapezoidalMap(const std::vector<Polygon<Scalar>>& faces, std::optional<std::uint32_t> seed) {
+    // Directed edges keyed by their lexicographically ordered ends; the two faces sharing an
+    // edge see it in opposite directions and land on its two sides.
+    struct FaceSide {
+        Point2D<Scalar> left;
+        Point2D<Scalar> right;
+        std::uint32_t face;
+        bool above;
+    };
+    std::vector<FaceSide> sides;
+    for (std::uint32_t face = 0; face < faces.size(); ++face) {
+        const auto& polygon = faces[face];
+        const bool counterClockwise = detail::signedArea(polygon) > Scalar{};
+        for (std::size_t i = 0; i < polygon.size(); ++i) {
+            const auto& start = polygon[i];
+            const auto& end = polygon[(i + 1) % polygon.size()];
+            if (detail::pointsIdentical(start, end)) {
+                continue;
+            }
+            const bool forward = detail::lexLessExact(start, end);
+            sides.push_back({forward ? start : end, forward ? end : start, face, forward == counterClockwise});
+        }
+    }
+    std::sort(sides.begin(), sides.end(), [](const FaceSide& lhs, const FaceSide& rhs) {
+        if (!detail::pointsIdentical(lhs.left, rhs.left)) {
+            return detail::lexLessExact(lhs.left, rhs.left);
+        }
+        return detail::lexLessExact(lhs.right, rhs.right);
+    });
+
+    std::vector<SubdivisionEdge<Scalar>> edges;
+    for (std::size_t i = 0; i < sides.size();) {
+        SubdivisionEdge<Scalar> edge{{sides[i].left, sides[i].right}};
+        std::size_t j = i;
+        for (; j < sides.size() && detail::pointsIdentical(sides[j].left, sides[i].left) &&
+               detail::pointsIdentical(sides[j].right, sides[i].right);
+             ++j) {
+            auto& label = sides[j].above ? edge.leftFace : edge.rightFace;
+            if (label != NoFace) {
+                throw std::invalid_argument("TrapezoidalMap faces overlap along an edge");
+            }
+            label = sides[j].face;
+        }
+        edges.push_back(edge);
+        i = j;
+    }
+    m_map = detail::buildTrapezoidDecomposition(edges, seed);
+}
+
+template <typename Scalar>
+TrapezoidalMap<Scalar>::TrapezoidalMap(const TriangleMesh<Scalar>& mesh, std::optional<std::uint32_t> seed) {
+    std::vector<SubdivisionEdge<Scalar>> edges;
+    for (std::uint32_t triangle = 0; triangle < mesh.triangles.size(); ++triangle) {
+        const auto& corners = mesh.triangles[triangle];
+        for (std::size_t i = 0; i < 3; ++i) {
+            const std::uint32_t neighbor = mesh.neighbors[triangle][i];
+            if (neighbor != TriangleMesh<Scalar>::NoNeighbor && neighbor < triangle) {
+                continue;
+            }
+            const auto& start = mesh.vertices[corners[(i + 1) % 3]];
+            const auto& end = mesh.vertices[corners[(i + 2) % 3]];
+            const std::uint32_t outside = neighbor == TriangleMesh<Scalar>::NoNeighbor ? NoFace : neighbor;
+            edges.push_back({{start, end}, triangle, outside});
+        }
+    }
+    m_map = detail::buildTrapezoidDecomposition(edges, seed);
+}
+
+template <typename Scalar>
+TrapezoidalMap<Scalar>::~TrapezoidalMap() = default;
+
+template <typename Scalar>
+TrapezoidalMap<Scalar>::TrapezoidalMap(TrapezoidalMap&& other) noexcept = default;
+
+template <typename Scalar>
+TrapezoidalMap<Scalar>& TrapezoidalMap<Scalar>::operator=(TrapezoidalMap&& other) noexcept = default;
+
+template <typename Scalar>
+std::uint32_t TrapezoidalMap<Scalar>::locate(const Point2D<Scalar>& point) const {
+    return m_map->locate(point);
+}
+
 template <typename Scalar>
 Point2D<Scalar> evaluateBezier(const std::vector<Point2D<Scalar>>& controlPoints,
                                const Scalar& t) {
@@ -1285,17 +5823,7 @@ Point2D<Scalar> evaluateBezier(const std::vector<Point2D<Scalar>>& controlPoints
         throw std::invalid_argument("Bezier parameter t must lie in [0, 1]");
     }
 
-    std::vector<Point2D<Scalar>> temp = controlPoints;
-    const Scalar oneMinusT = Scalar{1} - t;
-
-    for (std::size_t level = temp.size(); level > 1; --level) {
-        for (std::size_t i = 0; i < level - 1; ++i) {
-            temp[i].x = oneMinusT * temp[i].x + t * temp[i + 1].x;
-            temp[i].y = oneMinusT * temp[i].y + t * temp[i + 1].y;
-        }
-    }
-
-    return temp.front();
+    return detail::evaluateBezierInline(controlPoints, t);
 }
 
 template <typename Scalar>
@@ -1364,17 +5892,197 @@ std::vector<Point2D<Scalar>> sampleBezier(const std::vector<Point2D<Scalar>>& co
     std::vector<Point2D<Scalar>> samples;
     samples.reserve(sampleCount);
 
-    if (sampleCount == 1) {
-        samples.push_back(evaluateBezier(controlPoints, Scalar{}));
-        return samples;
+    switch (controlPoints.size()) {
+    case 2:
+        detail::sampleBezierCurve(BezierCurve<Scalar, 1>({controlPoints[0], controlPoints[1]}), sampleCount, samples);
+        break;
+    case 3:
+        detail::sampleBezierCurve(BezierCurve<Scalar, 2>({controlPoints[0], controlPoints[1], controlPoints[2]}),
+                                  sampleCount,
+                                  samples);
+        break;
+    case 4:
+        detail::sampleBezierCurve(
+            BezierCurve<Scalar, 3>({controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3]}),
+            sampleCount,
+            samples);
+        break;
+    default:
+        for (std::size_t i = 0; i < sampleCount; ++i) {
+            const Scalar t = sampleCount == 1 ? Scalar{}
+                                              : static_cast<Scalar>(i) / static_cast<Scalar>(sampleCount - 1);
+            samples.push_back(detail::evaluateBezierInline(controlPoints, t));
+        }
+        break;
+    }
+
+    return samples;
+}
+
+template <typename Scalar>
+void sampleBezierUniform(const std::vector<Point2D<Scalar>>& controlPoints,
+                         std::size_t sampleCount,
+                         std::vector<Point2D<Scalar>>& samples) {
+    if (sampleCount == 0) {
+        throw std::invalid_argument("sampleCount must be greater than zero");
+    }
+    if (controlPoints.empty()) {
+        throw std::invalid_argument("sampleBezierUniform requires control points");
+    }
+
+    samples.resize(sampleCount);
+    const std::size_t degree = controlPoints.size() - 1;
+    if (sampleCount <= degree + 1) {
+        for (std::size_t i = 0; i < sampleCount; ++i) {
+            const Scalar t = sampleCount == 1 ? Scalar{}
+                                              : static_cast<Scalar>(i) / static_cast<Scalar>(sampleCount - 1);
+            samples[i] = detail::evaluateBezierInline(controlPoints, t);
+        }
+        return;
+    }
+
+    // The difference table is rebuilt from the curve every AnchorInterval samples, so rounding
+    // drift stays bounded whatever sampleCount is.
+    constexpr std::size_t AnchorInterval = 32;
+    const std::size_t width = degree + 1;
+    std::array<Point2D<Scalar>, 4 * detail::InlineBezierPoints> pointBuffer;
+    std::array<Scalar, detail::InlineBezierPoints> scalarBuffer;
+    std::vector<Point2D<Scalar>> pointOverflow;
+    std::vector<Scalar> scalarOverflow;
+    Point2D<Scalar>* points = pointBuffer.data();
+    Scalar* scalars = scalarBuffer.data();
+    if (width > detail::InlineBezierPoints) {
+        pointOverflow.resize(4 * width);
+        scalarOverflow.resize(width);
+        points = pointOverflow.data();
+        scalars = scalarOverflow.data();
     }
+    Point2D<Scalar>* differences = points;
 
+    const Scalar step = Scalar{1} / static_cast<Scalar>(sampleCount - 1);
     for (std::size_t i = 0; i < sampleCount; ++i) {
-        const Scalar t = static_cast<Scalar>(i) / static_cast<Scalar>(sampleCount - 1);
-        samples.push_back(evaluateBezier(controlPoints, t));
+        if (i % AnchorInterval == 0) {
+            detail::bezierForwardDifferences(controlPoints, static_cast<Scalar>(i) * step, step, points, scalars);
+        } else {
+            for (std::size_t k = 0; k < degree; ++k) {
+                differences[k].x += differences[k + 1].x;
+                differences[k].y += differences[k + 1].y;
+            }
+        }
+        samples[i] = differences[0];
+    }
+    samples.back() = controlPoints.back();
+}
+
+template <typename Scalar>
+std::vector<Point2D<Scalar>> flattenBezier(const std::vector<Point2D<Scalar>>& controlPoints,
+                                           const Scalar& tolerance) {
+    if (controlPoints.empty()) {
+        throw std::invalid_argument("flattenBezier requires control points");
+    }
+    if (!(tolerance > Scalar{})) {
+        throw std::invalid_argument("flattenBezier tolerance must be positive");
     }
 
-    return samples;
+    std::vector<Point2D<Scalar>> polyline{controlPoints.front()};
+    const std::size_t width = controlPoints.size();
+    if (width == 1) {
+        return polyline;
+    }
+
+    // Depth first over the halves, left before right, so flat pieces come out in curve order.
+    // The depth cap only matters when rounding keeps a piece from ever passing the test.
+    constexpr unsigned MaxDepth = 24;
+    const auto offset = static_cast<std::ptrdiff_t>(width);
+    const Scalar half{0.5};
+    std::vector<Point2D<Scalar>> stack(controlPoints);
+    std::vector<unsigned> depths{0};
+    std::vector<Point2D<Scalar>> piece(width);
+    std::vector<Point2D<Scalar>> left(width);
+    std::vector<Point2D<Scalar>> right(width);
+    while (!depths.empty()) {
+        const unsigned depth = depths.back();
+        depths.pop_back();
+        std::copy(stack.end() - offset, stack.end(), piece.begin());
+        stack.resize(stack.size() - width);
+
+        if (depth >= MaxDepth || detail::bezierWithinTolerance(piece, tolerance)) {
+            polyline.push_back(piece.back());
+            continue;
+        }
+
+        // Halve at t = 1/2: level k of de Casteljau starts with the left half's k-th control
+        // point and ends with the right half's (d - k)-th.
+        left.front() = piece.front();
+        right.back() = piece.back();
+        for (std::size_t level = 1; level < width; ++level) {
+            for (std::size_t i = 0; i + level < width; ++i) {
+                piece[i] = {half * (piece[i].x + piece[i + 1].x), half * (piece[i].y + piece[i + 1].y)};
+            }
+            left[level] = piece.front();
+            right[width - 1 - level] = piece[width - 1 - level];
+        }
+        stack.insert(stack.end(), right.begin(), right.end());
+        stack.insert(stack.end(), left.begin(), left.end());
+        depths.push_back(depth + 1);
+        depths.push_back(depth + 1);
+    }
+    return polyline;
+}
+
+template <typename Scalar>
+void evaluateBezierCubicBatch(const CubicBezierBatch<Scalar>& curves,
+                              const std::vector<Scalar>& parameters,
+                              std::vector<Point2D<Scalar>>& result) {
+    const std::size_t curveCount = curves.size();
+    for (std::size_t k = 0; k < 4; ++k) {
+        if (curves.x[k].size() != curveCount || curves.y[k].size() != curveCount) {
+            throw std::invalid_argument("CubicBezierBatch columns must have equal length");
+        }
+    }
+
+    std::vector<std::array<Scalar, 4>> basis;
+    basis.reserve(parameters.size());
+    for (const auto& t : parameters) {
+        if (t < Scalar{} || t > Scalar{1}) {
+            throw std::invalid_argument("Bezier parameter t must lie in [0, 1]");
+        }
+        basis.push_back(detail::cubicBernstein(t));
+    }
+
+    result.resize(curveCount * parameters.size());
+    std::size_t first = 0;
+    if constexpr (std::is_same_v<Scalar, double>) {
+        first = detail::evaluateBezierCubicBatchVector(curves, basis, result);
+    }
+    for (std::size_t j = 0; j < basis.size(); ++j) {
+        const auto& [b0, b1, b2, b3] = basis[j];
+        Point2D<Scalar>* row = result.data() + j * curveCount;
+        for (std::size_t i = first; i < curveCount; ++i) {
+            row[i] = {b0 * curves.x[0][i] + b1 * curves.x[1][i] + b2 * curves.x[2][i] + b3 * curves.x[3][i],
+                      b0 * curves.y[0][i] + b1 * curves.y[1][i] + b2 * curves.y[2][i] + b3 * curves.y[3][i]};
+        }
+    }
+}
+
+template <typename Scalar>
+std::vector<BezierIntersection<Scalar>> intersectBezierCurves(const std::vector<Point2D<Scalar>>& first,
+                                                              const std::vector<Point2D<Scalar>>& second,
+                                                              const Scalar& epsilon) {
+    if (first.size() < 2 || second.size() < 2) {
+        throw std::invalid_argument("intersectBezierCurves requires at least two control points per curve");
+    }
+    return detail::clipBezierCurves(first, second, epsilon);
+}
+
+template <typename Scalar>
+std::vector<BezierIntersection<Scalar>> intersectBezierSegment(const std::vector<Point2D<Scalar>>& curve,
+                                                               const Segment2D<Scalar>& segment,
+                                                               const Scalar& epsilon) {
+    if (curve.size() < 2) {
+        throw std::invalid_argument("intersectBezierSegment requires at least two control points");
+    }
+    return detail::clipBezierCurves(curve, std::vector<Point2D<Scalar>>{segment.start, segment.end}, epsilon);
 }
 
 // Explicit instantiations for double and ExactScalar
@@ -1382,58 +6090,156 @@ std::vector<Point2D<Scalar>> sampleBezier(const std::vector<Point2D<Scalar>>& co
 #ifndef PLANE_GEOMETRY_SKIP_EXPLICIT_INSTANTIATIONS
 template Orientation classifyPointRelativeToSegment<double>(const Segment2D<double>&,
                                                             const Point2D<double>&,
-                                                            const double&);
+                                                            const double&,
+                                                            PredicateKernel);
 template Orientation classifyPointRelativeToSegment<ExactScalar>(const Segment2D<ExactScalar>&,
                                                                 const Point2D<ExactScalar>&,
-                                                                const ExactScalar&);
+                                                                const ExactScalar&,
+                                                                PredicateKernel);
 
 template SegmentIntersectionResult<double> intersectSegments<double>(const Segment2D<double>&,
                                                                       const Segment2D<double>&,
-                                                                      const double&);
+                                                                      const double&,
+                                                                      PredicateKernel);
 template SegmentIntersectionResult<ExactScalar> intersectSegments<ExactScalar>(const Segment2D<ExactScalar>&,
                                                                               const Segment2D<ExactScalar>&,
-                                                                              const ExactScalar&);
-
-template std::vector<Point2D<double>> computeConvexHull<double>(const std::vector<Point2D<double>>&);
-template std::vector<Point2D<ExactScalar>> computeConvexHull<ExactScalar>(const std::vector<Point2D<ExactScalar>>&);
-
-template std::vector<Triangle2D<double>> delaunayTriangulation<double>(const std::vector<Point2D<double>>&);
-template std::vector<Triangle2D<ExactScalar>> delaunayTriangulation<ExactScalar>(const std::vector<Point2D<ExactScalar>>&);
+                                                                              const ExactScalar&,
+                                                                              PredicateKernel);
+template std::vector<SegmentPairIntersection<double>> intersectAllSegments<double>(
+    const std::vector<Segment2D<double>>&, const double&, PredicateKernel);
+template std::vector<SegmentPairIntersection<ExactScalar>> intersectAllSegments<ExactScalar>(
+    const std::vector<Segment2D<ExactScalar>>&, const ExactScalar&, PredicateKernel);
+
+template std::vector<Point2D<double>> computeConvexHull<double>(const std::vector<Point2D<double>>&,
+                                                                PredicateKernel);
+template std::vector<Point2D<ExactScalar>> computeConvexHull<ExactScalar>(const std::vector<Point2D<ExactScalar>>&,
+                                                                          PredicateKernel);
+
+template std::vector<Triangle2D<double>> delaunayTriangulation<double>(const std::vector<Point2D<double>>&,
+                                                                       PredicateKernel);
+template std::vector<Triangle2D<ExactScalar>> delaunayTriangulation<ExactScalar>(const std::vector<Point2D<ExactScalar>>&,
+                                                                                 PredicateKernel);
+template std::vector<Triangle2D<double>> delaunayTriangulation<double>(const std::vector<Point2D<double>>&,
+                                                                       const DelaunayOptions&);
+template std::vector<Triangle2D<ExactScalar>> delaunayTriangulation<ExactScalar>(const std::vector<Point2D<ExactScalar>>&,
+                                                                                 const DelaunayOptions&);
+template TriangleMesh<double> delaunayTriangulationMesh<double>(const std::vector<Point2D<double>>&,
+                                                                const DelaunayOptions&);
+template TriangleMesh<ExactScalar> delaunayTriangulationMesh<ExactScalar>(const std::vector<Point2D<ExactScalar>>&,
+                                                                          const DelaunayOptions&);
+
+template TriangleMesh<double> constrainedDelaunayTriangulation<double>(const std::vector<Point2D<double>>&,
+                                                                       const std::vector<std::array<std::uint32_t, 2>>&,
+                                                                       PredicateKernel);
+template TriangleMesh<ExactScalar> constrainedDelaunayTriangulation<ExactScalar>(const std::vector<Point2D<ExactScalar>>&,
+                                                                                 const std::vector<std::array<std::uint32_t, 2>>&,
+                                                                                 PredicateKernel);
+template TriangleMesh<double> triangulateRegion<double>(const BooleanResult<double>&, PredicateKernel);
+template TriangleMesh<ExactScalar> triangulateRegion<ExactScalar>(const BooleanResult<ExactScalar>&, PredicateKernel);
+
+template class DynamicDelaunayTriangulation<double>;
+template class DynamicDelaunayTriangulation<ExactScalar>;
+
+template class BooleanOverlay<double>;
+template class BooleanOverlay<ExactScalar>;
+
+template class ConvexPolygonLocator<double>;
+template class ConvexPolygonLocator<ExactScalar>;
+
+template class PolygonLocator<double>;
+template class PolygonLocator<ExactScalar>;
+
+template class TrapezoidalMap<double>;
+template class TrapezoidalMap<ExactScalar>;
 
 template Polygon<double> intersectConvexPolygons<double>(const Polygon<double>&,
                                                           const Polygon<double>&,
-                                                          const double&);
+                                                          const double&,
+                                                          PredicateKernel);
 template Polygon<ExactScalar> intersectConvexPolygons<ExactScalar>(const Polygon<ExactScalar>&,
                                                                    const Polygon<ExactScalar>&,
-                                                                   const ExactScalar&);
+                                                                   const ExactScalar&,
+                                                                   PredicateKernel);
 
 template BooleanResult<double> unionConvexPolygons<double>(const Polygon<double>&,
                                                       const Polygon<double>&,
-                                                      const double&);
+                                                      const double&,
+                                                      PredicateKernel);
 template BooleanResult<ExactScalar> unionConvexPolygons<ExactScalar>(const Polygon<ExactScalar>&,
                                                                const Polygon<ExactScalar>&,
-                                                               const ExactScalar&);
+                                                               const ExactScalar&,
+                                                               PredicateKernel);
 
 template BooleanResult<double> differenceConvexPolygons<double>(const Polygon<double>&,
                                                            const Polygon<double>&,
-                                                           const double&);
+                                                           const double&,
+                                                           PredicateKernel);
 template BooleanResult<ExactScalar> differenceConvexPolygons<ExactScalar>(const Polygon<ExactScalar>&,
                                                                     const Polygon<ExactScalar>&,
-                                                                    const ExactScalar&);
+                                                                    const ExactScalar&,
+                                                                    PredicateKernel);
+
+template BooleanResult<double> booleanOperation<double>(const BooleanResult<double>&,
+                                                        const BooleanResult<double>&,
+                                                        BooleanOperation,
+                                                        const double&,
+                                                        PredicateKernel);
+template BooleanResult<ExactScalar> booleanOperation<ExactScalar>(const BooleanResult<ExactScalar>&,
+                                                                  const BooleanResult<ExactScalar>&,
+                                                                  BooleanOperation,
+                                                                  const ExactScalar&,
+                                                                  PredicateKernel);
+template BooleanResult<double> booleanOperation<double>(const Polygon<double>&,
+                                                        const Polygon<double>&,
+                                                        BooleanOperation,
+                                                        const double&,
+                                                        PredicateKernel);
+template BooleanResult<ExactScalar> booleanOperation<ExactScalar>(const Polygon<ExactScalar>&,
+                                                                  const Polygon<ExactScalar>&,
+                                                                  BooleanOperation,
+                                                                  const ExactScalar&,
+                                                                  PredicateKernel);
+
+template BooleanResult<double> xorPolygons<double>(const Polygon<double>&,
+                                                   const Polygon<double>&,
+                                                   const double&,
+                                                   PredicateKernel);
+template BooleanResult<ExactScalar> xorPolygons<ExactScalar>(const Polygon<ExactScalar>&,
+                                                             const Polygon<ExactScalar>&,
+                                                             const ExactScalar&,
+                                                             PredicateKernel);
+template BooleanResult<double> unionAll<double>(const std::vector<Polygon<double>>&,
+                                                const double&,
+                                                PredicateKernel,
+                                                unsigned);
+template BooleanResult<ExactScalar> unionAll<ExactScalar>(const std::vector<Polygon<ExactScalar>>&,
+                                                          const ExactScalar&,
+                                                          PredicateKernel,
+                                                          unsigned);
 
 template PointClassification locatePointInConvexPolygon<double>(const Polygon<double>&,
                                                                 const Point2D<double>&,
-                                                                const double&);
+                                                                const double&,
+                                                                PredicateKernel);
 template PointClassification locatePointInConvexPolygon<ExactScalar>(const Polygon<ExactScalar>&,
                                                                     const Point2D<ExactScalar>&,
-                                                                    const ExactScalar&);
+                                                                    const ExactScalar&,
+                                                                    PredicateKernel);
 
 template PointClassification locatePointInPolygon<double>(const Polygon<double>&,
                                                           const Point2D<double>&,
-                                                          const double&);
+                                                          const double&,
+                                                          PredicateKernel);
 template PointClassification locatePointInPolygon<ExactScalar>(const Polygon<ExactScalar>&,
                                                               const Point2D<ExactScalar>&,
-                                                              const ExactScalar&);
+                                                              const ExactScalar&,
+                                                              PredicateKernel);
+template std::vector<PointClassification> locatePointsInPolygon<double>(const Polygon<double>&,
+                                                                        const std::vector<Point2D<double>>&,
+                                                                        const double&,
+                                                                        PredicateKernel);
+template std::vector<PointClassification> locatePointsInPolygon<ExactScalar>(
+    const Polygon<ExactScalar>&, const std::vector<Point2D<ExactScalar>>&, const ExactScalar&, PredicateKernel);
 
 template Point2D<double> evaluateBezier<double>(const std::vector<Point2D<double>>&,
                                                 const double&);
@@ -1471,6 +6277,31 @@ template std::vector<Point2D<double>> sampleBezier<double>(const std::vector<Poi
                                                            std::size_t);
 template std::vector<Point2D<ExactScalar>> sampleBezier<ExactScalar>(const std::vector<Point2D<ExactScalar>>&,
                                                                     std::size_t);
+template void sampleBezierUniform<double>(const std::vector<Point2D<double>>&,
+                                         std::size_t,
+                                         std::vector<Point2D<double>>&);
+template void sampleBezierUniform<ExactScalar>(const std::vector<Point2D<ExactScalar>>&,
+                                              std::size_t,
+                                              std::vector<Point2D<ExactScalar>>&);
+template void evaluateBezierCubicBatch<double>(const CubicBezierBatch<double>&,
+                                              const std::vector<double>&,
+                                              std::vector<Point2D<double>>&);
+template void evaluateBezierCubicBatch<ExactScalar>(const CubicBezierBatch<ExactScalar>&,
+                                                   const std::vector<ExactScalar>&,
+                                                   std::vector<Point2D<ExactScalar>>&);
+template std::vector<BezierIntersection<double>> intersectBezierCurves<double>(const std::vector<Point2D<double>>&,
+                                                                            const std::vector<Point2D<double>>&,
+                                                                            const double&);
+template std::vector<BezierIntersection<ExactScalar>> intersectBezierCurves<ExactScalar>(
+    const std::vector<Point2D<ExactScalar>>&, const std::vector<Point2D<ExactScalar>>&, const ExactScalar&);
+template std::vector<BezierIntersection<double>> intersectBezierSegment<double>(const std::vector<Point2D<double>>&,
+                                                                             const Segment2D<double>&,
+                                                                             const double&);
+template std::vector<BezierIntersection<ExactScalar>> intersectBezierSegment<ExactScalar>(
+    const std::vector<Point2D<ExactScalar>>&, const Segment2D<ExactScalar>&, const ExactScalar&);
+template std::vector<Point2D<double>> flattenBezier<double>(const std::vector<Point2D<double>>&, const double&);
+template std::vector<Point2D<ExactScalar>> flattenBezier<ExactScalar>(const std::vector<Point2D<ExactScalar>>&,
+                                                                      const ExactScalar&);
 #endif  // PLANE_GEOMETRY_SKIP_EXPLICIT_INSTANTIATIONS
 
 }  // namespace plane_geometry
@@ -2,6 +2,11 @@
 
 #include <boost/multiprecision/cpp_dec_float.hpp>
 #include <boost/multiprecision/fwd.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <type_traits>
 #include <vector>
 
@@ -30,6 +35,15 @@ struct Segment2D {
     Point2D<Scalar> end;
 };
 
+// Predicate kernel used for sign decisions (orientation, in-circle, containment).
+// Tolerance compares determinants against epsilon. Filtered returns exact signs: double input
+// uses adaptive-precision expansion arithmetic, other scalars are evaluated in double with a
+// certified error bound and fall back to ExactScalar only when the sign is uncertain.
+enum class PredicateKernel : int {
+    Tolerance = 0,
+    Filtered = 1
+};
+
 enum class Orientation : int {
     Right = -1,
     OnSegment = 0,
@@ -59,18 +73,116 @@ struct Triangle2D {
 template <typename Scalar>
 Orientation classifyPointRelativeToSegment(const Segment2D<Scalar>& segment,
                                            const Point2D<Scalar>& point,
-                                           const Scalar& epsilon = defaultEpsilon<Scalar>());
+                                           const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                           PredicateKernel kernel = PredicateKernel::Tolerance);
 
 template <typename Scalar>
 SegmentIntersectionResult<Scalar> intersectSegments(const Segment2D<Scalar>& first,
                                                     const Segment2D<Scalar>& second,
-                                                    const Scalar& epsilon = defaultEpsilon<Scalar>());
+                                                    const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                                    PredicateKernel kernel = PredicateKernel::Tolerance);
+
+template <typename Scalar>
+struct SegmentPairIntersection {
+    std::uint32_t first{};
+    std::uint32_t second{};
+    SegmentIntersectionResult<Scalar> result{};
+};
+
+// All intersecting pairs among the segments, found with a Bentley-Ottmann sweep in
+// O((N + K) log N). Pairs are reported once with first < second, sorted, and each result is
+// exactly what intersectSegments returns for that pair. Under the tolerance kernel the sweep
+// also carries a probe cross at every endpoint, sized by the segments ending there, so that near
+// misses are found as well. Not searched for are pairs the tolerance kernel only takes as nearly
+// collinear because its allowance grows with their distance, as for a segment a few epsilon
+// long lying well off a longer one.
+template <typename Scalar>
+std::vector<SegmentPairIntersection<Scalar>> intersectAllSegments(const std::vector<Segment2D<Scalar>>& segments,
+                                                                  const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                                                  PredicateKernel kernel = PredicateKernel::Tolerance);
+
 template <typename Scalar>
-std::vector<Point2D<Scalar>> computeConvexHull(const std::vector<Point2D<Scalar>>& points);
+std::vector<Point2D<Scalar>> computeConvexHull(const std::vector<Point2D<Scalar>>& points,
+                                               PredicateKernel kernel = PredicateKernel::Tolerance);
+
+
+// Insertion order is a biased randomized order: shuffled rounds of doubling size, each sorted
+// along a Hilbert curve. A fixed seed makes the order, and so the timing, reproducible.
+// parallel switches to Guibas-Stolfi divide and conquer over the sorted points; threadCount 0
+// uses every hardware thread. That path always runs exact predicates, also when kernel asks for
+// Tolerance, and where four or more points are cocircular it may settle the tie differently from
+// the sequential path: both results are Delaunay, but their triangles can differ.
+struct DelaunayOptions {
+    PredicateKernel kernel = PredicateKernel::Tolerance;
+    std::optional<std::uint32_t> seed;
+    bool parallel = false;
+    unsigned threadCount = 0;
+};
 
+template <typename Scalar>
+std::vector<Triangle2D<Scalar>> delaunayTriangulation(const std::vector<Point2D<Scalar>>& points,
+                                                      PredicateKernel kernel = PredicateKernel::Tolerance);
+
+template <typename Scalar>
+std::vector<Triangle2D<Scalar>> delaunayTriangulation(const std::vector<Point2D<Scalar>>& points,
+                                                      const DelaunayOptions& options);
 
+// Indexed triangulation: CCW triangles index into the shared vertex array, and neighbors[t][i]
+// is the triangle across the edge opposite triangles[t][i], or NoNeighbor on the hull.
 template <typename Scalar>
-std::vector<Triangle2D<Scalar>> delaunayTriangulation(const std::vector<Point2D<Scalar>>& points);
+struct TriangleMesh {
+    static constexpr std::uint32_t NoNeighbor = 0xFFFFFFFFu;
+
+    std::vector<Point2D<Scalar>> vertices;
+    std::vector<std::array<std::uint32_t, 3>> triangles;
+    std::vector<std::array<std::uint32_t, 3>> neighbors;
+};
+
+template <typename Scalar>
+TriangleMesh<Scalar> delaunayTriangulationMesh(const std::vector<Point2D<Scalar>>& points,
+                                               const DelaunayOptions& options = {});
+
+// Constrained Delaunay triangulation: each constraint, a pair of indices into points, appears
+// as a chain of mesh edges. The vertex array is points itself; exact duplicates are left
+// unreferenced and a constraint through a vertex is split there. Crossing constraints throw
+// std::invalid_argument.
+template <typename Scalar>
+TriangleMesh<Scalar> constrainedDelaunayTriangulation(const std::vector<Point2D<Scalar>>& points,
+                                                      const std::vector<std::array<std::uint32_t, 2>>& constraints,
+                                                      PredicateKernel kernel = PredicateKernel::Tolerance);
+
+namespace detail {
+template <typename Scalar>
+class Triangulation;
+}
+
+// Delaunay triangulation updated in place: insert, remove and move only repair the affected
+// star. Vertex ids stay valid until the vertex is removed and are then reused. mesh() indexes
+// its vertex array by id, so removed ids are simply not referenced by any triangle.
+template <typename Scalar>
+class DynamicDelaunayTriangulation {
+public:
+    static constexpr std::uint32_t InvalidVertex = 0xFFFFFFFFu;
+
+    explicit DynamicDelaunayTriangulation(PredicateKernel kernel = PredicateKernel::Tolerance);
+    ~DynamicDelaunayTriangulation();
+    DynamicDelaunayTriangulation(DynamicDelaunayTriangulation&& other) noexcept;
+    DynamicDelaunayTriangulation& operator=(DynamicDelaunayTriangulation&& other) noexcept;
+
+    // Returns InvalidVertex when the point coincides with an existing vertex.
+    std::uint32_t insert(const Point2D<Scalar>& point);
+    bool remove(std::uint32_t vertex);
+    // Returns false, leaving the vertex where it was, when the target coincides with another vertex.
+    bool move(std::uint32_t vertex, const Point2D<Scalar>& point);
+    void clear();
+
+    std::size_t vertexCount() const;
+    TriangleMesh<Scalar> mesh() const;
+
+private:
+    PredicateKernel m_kernel;
+    std::unique_ptr<detail::Triangulation<Scalar>> m_triangulation;
+};
 
 template <typename Scalar> 
 using Polygon = std::vector<Point2D<Scalar>>;
@@ -83,20 +195,102 @@ struct BooleanResult {
     bool empty() const { return outers.empty() && holes.empty(); }
 };
 
+// Constrained Delaunay triangulation of the area enclosed by the outers minus the holes
+// (even-odd over all contours). Vertices are the contour points, outers first.
+template <typename Scalar>
+TriangleMesh<Scalar> triangulateRegion(const BooleanResult<Scalar>& region,
+                                       PredicateKernel kernel = PredicateKernel::Tolerance);
+
 template <typename Scalar> 
 Polygon<Scalar> intersectConvexPolygons(const Polygon<Scalar>& polyA, 
                                         const Polygon<Scalar>& polyB, 
-                                        const Scalar& epsilon = defaultEpsilon<Scalar>());
+                                        const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                        PredicateKernel kernel = PredicateKernel::Tolerance);
 
 template <typename Scalar> 
 BooleanResult<Scalar> unionConvexPolygons(const Polygon<Scalar>& polyA, 
                                            const Polygon<Scalar>& polyB, 
-                                           const Scalar& epsilon = defaultEpsilon<Scalar>());
+                                           const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                           PredicateKernel kernel = PredicateKernel::Tolerance);
 
 template <typename Scalar> 
 BooleanResult<Scalar> differenceConvexPolygons(const Polygon<Scalar>& polyA, 
                                          const Polygon<Scalar>& polyB, 
-                                         const Scalar& epsilon = defaultEpsilon<Scalar>());
+                                         const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                         PredicateKernel kernel = PredicateKernel::Tolerance);
+
+enum class BooleanOperation : int {
+    Union = 0,
+    Intersection = 1,
+    Difference = 2,
+    Xor = 3
+};
+
+namespace detail {
+template <typename Scalar>
+struct Arrangement;
+}
+
+// Overlay of two regions: intersections are found, edges split and both sides of every
+// fragment classified once in the constructor; compute() then only traces the contours of the
+// requested operation, so several operations on the same pair share the split.
+template <typename Scalar>
+class BooleanOverlay {
+public:
+    BooleanOverlay(const BooleanResult<Scalar>& regionA,
+                   const BooleanResult<Scalar>& regionB,
+                   const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                   PredicateKernel kernel = PredicateKernel::Tolerance);
+    BooleanOverlay(const Polygon<Scalar>& polyA,
+                   const Polygon<Scalar>& polyB,
+                   const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                   PredicateKernel kernel = PredicateKernel::Tolerance);
+    ~BooleanOverlay();
+    BooleanOverlay(BooleanOverlay&& other) noexcept;
+    BooleanOverlay& operator=(BooleanOverlay&& other) noexcept;
+
+    BooleanResult<Scalar> compute(BooleanOperation operation) const;
+
+private:
+    Scalar m_epsilon;
+    PredicateKernel m_kernel;
+    std::unique_ptr<detail::Arrangement<Scalar>> m_arrangement;
+};
+
+// Boolean operation on arbitrary regions: every contour of each operand, outer or hole, in any
+// orientation, bounds its region under the even-odd rule, so non-convex, self-intersecting and
+// holed inputs are all accepted. Runs in O((n + k) log n) for n edges with k intersections.
+// The result has CCW outers and CW holes.
+template <typename Scalar>
+BooleanResult<Scalar> booleanOperation(const BooleanResult<Scalar>& regionA,
+                                       const BooleanResult<Scalar>& regionB,
+                                       BooleanOperation operation,
+                                       const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                       PredicateKernel kernel = PredicateKernel::Tolerance);
+
+template <typename Scalar>
+BooleanResult<Scalar> booleanOperation(const Polygon<Scalar>& polyA,
+                                       const Polygon<Scalar>& polyB,
+                                       BooleanOperation operation,
+                                       const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                       PredicateKernel kernel = PredicateKernel::Tolerance);
+
+// Symmetric difference in a single pass: the edges are split and classified once, and an edge
+// is kept when exactly one side lies in exactly one operand.
+template <typename Scalar>
+BooleanResult<Scalar> xorPolygons(const Polygon<Scalar>& polyA,
+                                  const Polygon<Scalar>& polyB,
+                                  const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                  PredicateKernel kernel = PredicateKernel::Tolerance);
+
+// Union of many polygons as a cascade: polygons are ordered along a Hilbert curve by their
+// bounding-box centres and merged pairwise up a balanced tree with booleanOperation.
+// Independent subtrees run concurrently; threadCount 0 uses every hardware thread.
+template <typename Scalar>
+BooleanResult<Scalar> unionAll(const std::vector<Polygon<Scalar>>& polygons,
+                               const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                               PredicateKernel kernel = PredicateKernel::Tolerance,
+                               unsigned threadCount = 0);
 
 enum class PointClassification : int {
     Outside = -1,
@@ -107,12 +301,127 @@ enum class PointClassification : int {
 template <typename Scalar>
 PointClassification locatePointInConvexPolygon(const Polygon<Scalar>& polygon,
                                                const Point2D<Scalar>& point,
-                                               const Scalar& epsilon = defaultEpsilon<Scalar>());
+                                               const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                               PredicateKernel kernel = PredicateKernel::Tolerance);
+
+// Build-once point location in a convex polygon: the polygon is cut into a fan of wedges
+// around its first vertex, and a query binary-searches its wedge and tests only the edges
+// next to it, in O(log n). Answers match locatePointInConvexPolygon.
+template <typename Scalar>
+class ConvexPolygonLocator {
+public:
+    explicit ConvexPolygonLocator(Polygon<Scalar> polygon,
+                                  const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                  PredicateKernel kernel = PredicateKernel::Tolerance);
+
+    PointClassification locate(const Point2D<Scalar>& point) const;
+
+private:
+    Polygon<Scalar> m_polygon;
+    Scalar m_epsilon;
+    PredicateKernel m_kernel;
+    bool m_degenerate{false};
+    bool m_clockwise{false};
+};
 
 template <typename Scalar>
 PointClassification locatePointInPolygon(const Polygon<Scalar>& polygon,
                                          const Point2D<Scalar>& point,
-                                         const Scalar& epsilon = defaultEpsilon<Scalar>());
+                                         const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                         PredicateKernel kernel = PredicateKernel::Tolerance);
+
+// Classifies many points against the same polygon, matching locatePointInPolygon point by
+// point. For double the edges are laid out as arrays and run through an SSE2/AVX2 crossing
+// kernel; only points the vector pass cannot decide (near an edge) go through the scalar path.
+template <typename Scalar>
+std::vector<PointClassification> locatePointsInPolygon(const Polygon<Scalar>& polygon,
+                                                       const std::vector<Point2D<Scalar>>& points,
+                                                       const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                                                       PredicateKernel kernel = PredicateKernel::Tolerance);
+
+// Edge of a planar subdivision with the labels of the faces to its left and right, looking from
+// start to end. NoFace stands for the unbounded side.
+template <typename Scalar>
+struct SubdivisionEdge {
+    static constexpr std::uint32_t NoFace = 0xFFFFFFFFu;
+
+    Segment2D<Scalar> segment;
+    std::uint32_t leftFace{NoFace};
+    std::uint32_t rightFace{NoFace};
+};
+
+namespace detail {
+template <typename Scalar>
+class TrapezoidDecomposition;
+}
+
+// Face location in a planar subdivision through a randomized incremental trapezoidal map:
+// expected O(n) size and O(log n) queries, with exact predicates. Edges may only meet at shared
+// endpoints; violations found while building throw std::invalid_argument. The face and mesh
+// constructors label face (triangle) i with i and pair up shared edges. locate() returns NoFace
+// outside every face and one of the faces around a point on an edge or vertex, also where only
+// one side is labelled; it is const and safe for concurrent readers.
+template <typename Scalar>
+class TrapezoidalMap {
+public:
+    static constexpr std::uint32_t NoFace = SubdivisionEdge<Scalar>::NoFace;
+
+    explicit TrapezoidalMap(const std::vector<SubdivisionEdge<Scalar>>& edges,
+                            std::optional<std::uint32_t> seed = std::nullopt);
+    explicit TrapezoidalMap(const std::vector<Polygon<Scalar>>& faces,
+                            std::optional<std::uint32_t> seed = std::nullopt);
+    explicit TrapezoidalMap(const TriangleMesh<Scalar>& mesh, std::optional<std::uint32_t> seed = std::nullopt);
+    ~TrapezoidalMap();
+    TrapezoidalMap(TrapezoidalMap&& other) noexcept;
+    TrapezoidalMap& operator=(TrapezoidalMap&& other) noexcept;
+
+    std::uint32_t locate(const Point2D<Scalar>& point) const;
+
+private:
+    std::unique_ptr<detail::TrapezoidDecomposition<Scalar>> m_map;
+};
+
+// Build-once point location in a simple polygon: expected O(n) size and O(log n) per query. A
+// trapezoidal map of the edges tells inside from outside with exact predicates. When the point's
+// trapezoid leaves less room around it than pointOnSegment reaches, a bounding-box tree over the
+// edges finds the few that can hold it on the boundary. Answers match locatePointInPolygon
+// except off the boundary under the tolerance kernel, whose side test may count a point nearly
+// in line with an edge as on it; the locator keeps the exact side. Edges meeting other than at
+// shared vertices throw std::invalid_argument. locate() is const and safe for concurrent
+// readers.
+template <typename Scalar>
+class PolygonLocator {
+public:
+    explicit PolygonLocator(Polygon<Scalar> polygon,
+                            const Scalar& epsilon = defaultEpsilon<Scalar>(),
+                            PredicateKernel kernel = PredicateKernel::Tolerance);
+    ~PolygonLocator();
+    PolygonLocator(PolygonLocator&& other) noexcept;
+    PolygonLocator& operator=(PolygonLocator&& other) noexcept;
+
+    PointClassification locate(const Point2D<Scalar>& point) const;
+
+private:
+    // Leaves hold count edges from m_order[first]; inner nodes have count 0 and their children
+    // at first and first + 1.
+    struct Node {
+        std::array<double, 4> box{};
+        std::uint32_t first{};
+        std::uint32_t count{};
+    };
+
+    void buildNode(std::uint32_t node, std::uint32_t first, std::uint32_t last,
+                   const std::vector<std::array<double, 4>>& boxes);
+    bool onBoundary(const Point2D<Scalar>& point) const;
+
+    Polygon<Scalar> m_polygon;
+    Scalar m_epsilon;
+    PredicateKernel m_kernel;
+    double m_reach{};
+    std::unique_ptr<detail::TrapezoidDecomposition<Scalar>> m_map;
+    std::vector<Node> m_nodes;
+    std::vector<std::uint32_t> m_order;
+};
 
 template <typename Scalar>
 Point2D<Scalar> evaluateBezier(const std::vector<Point2D<Scalar>>& controlPoints,
@@ -136,8 +445,121 @@ Point2D<Scalar> evaluateBezierCubic(const Point2D<Scalar>& p0,
                                     const Point2D<Scalar>& p3,
                                     const Scalar& t);
 
+// Bezier curve of compile-time degree N. The control points are stored inline and evaluate()
+// runs de Casteljau on a stack copy, so evaluation never allocates; it matches evaluateBezier
+// bit for bit.
+template <typename Scalar, std::size_t N>
+class BezierCurve {
+public:
+    static constexpr std::size_t Degree = N;
+
+    BezierCurve() = default;
+    explicit BezierCurve(const std::array<Point2D<Scalar>, N + 1>& controlPoints)
+        : m_controlPoints(controlPoints) {}
+
+    const std::array<Point2D<Scalar>, N + 1>& controlPoints() const { return m_controlPoints; }
+
+    Point2D<Scalar> evaluate(const Scalar& t) const {
+        if (t < Scalar{} || t > Scalar{1}) {
+            throw std::invalid_argument("Bezier parameter t must lie in [0, 1]");
+        }
+        std::array<Point2D<Scalar>, N + 1> temp = m_controlPoints;
+        const Scalar oneMinusT = Scalar{1} - t;
+        for (std::size_t level = N + 1; level > 1; --level) {
+            for (std::size_t i = 0; i < level - 1; ++i) {
+                temp[i].x = oneMinusT * temp[i].x + t * temp[i + 1].x;
+                temp[i].y = oneMinusT * temp[i].y + t * temp[i + 1].y;
+            }
+        }
+        return temp.front();
+    }
+
+private:
+    std::array<Point2D<Scalar>, N + 1> m_controlPoints{};
+};
+
+// Cubic Bezier curves stored column-wise: x[k][i] and y[k][i] are control point k of curve i.
+template <typename Scalar>
+struct CubicBezierBatch {
+    std::array<std::vector<Scalar>, 4> x;
+    std::array<std::vector<Scalar>, 4> y;
+
+    std::size_t size() const { return x[0].size(); }
+    void reserve(std::size_t count) {
+        for (std::size_t k = 0; k < 4; ++k) {
+            x[k].reserve(count);
+            y[k].reserve(count);
+        }
+    }
+    void push_back(const Point2D<Scalar>& p0,
+                   const Point2D<Scalar>& p1,
+                   const Point2D<Scalar>& p2,
+                   const Point2D<Scalar>& p3) {
+        const Point2D<Scalar>* points[4] = {&p0, &p1, &p2, &p3};
+        for (std::size_t k = 0; k < 4; ++k) {
+            x[k].push_back(points[k]->x);
+            y[k].push_back(points[k]->y);
+        }
+    }
+    void clear() {
+        for (std::size_t k = 0; k < 4; ++k) {
+            x[k].clear();
+            y[k].clear();
+        }
+    }
+};
+
+// Evaluates every curve at every parameter: result[j * curves.size() + i] is curve i at
+// parameters[j], computed with the same arithmetic as evaluateBezierCubic. The Bernstein weights
+// are tabulated once per parameter; for double, 4 curves (AVX2) or 2 (SSE2) go per vector.
+// result is resized and its storage reused.
+template <typename Scalar>
+void evaluateBezierCubicBatch(const CubicBezierBatch<Scalar>& curves,
+                              const std::vector<Scalar>& parameters,
+                              std::vector<Point2D<Scalar>>& result);
+
 template <typename Scalar>
 std::vector<Point2D<Scalar>> sampleBezier(const std::vector<Point2D<Scalar>>& controlPoints,
                                           std::size_t sampleCount);
 
+// Same parameters as sampleBezier, by forward differencing: the difference table is re-anchored
+// on the curve every 32 samples and each sample in between costs one addition per degree.
+// The end points are exact.
+// samples is resized to sampleCount and its storage reused, so repeated calls do not allocate.
+template <typename Scalar>
+void sampleBezierUniform(const std::vector<Point2D<Scalar>>& controlPoints,
+                         std::size_t sampleCount,
+                         std::vector<Point2D<Scalar>>& samples);
+
+// Polyline through points of the curve that stays within tolerance of it: pieces are halved
+// until all their control points lie within tolerance of the piece's chord, so flat stretches
+// get few vertices and tight bends many. Starts and ends on the curve's end points.
+template <typename Scalar>
+std::vector<Point2D<Scalar>> flattenBezier(const std::vector<Point2D<Scalar>>& controlPoints,
+                                           const Scalar& tolerance);
+
+// Intersection of two curves: the parameter on each and the point on the first curve there.
+template <typename Scalar>
+struct BezierIntersection {
+    Scalar firstParameter{};
+    Scalar secondParameter{};
+    Point2D<Scalar> point{};
+};
+
+// Intersections of two Bezier curves of any degree by Bezier clipping against fat lines, with
+// bounding-box pruning and halving where clipping stalls. Points closer than epsilon count as
+// meeting and results are sorted by firstParameter. Hits chained closer than a few epsilon are
+// reported once, so a tangency gives one point and an overlapping stretch gives few.
+template <typename Scalar>
+std::vector<BezierIntersection<Scalar>> intersectBezierCurves(const std::vector<Point2D<Scalar>>& first,
+                                                              const std::vector<Point2D<Scalar>>& second,
+                                                              const Scalar& epsilon = defaultEpsilon<Scalar>());
+
+// As intersectBezierCurves with the segment as the second curve; secondParameter runs from
+// segment.start (0) to segment.end (1).
+template <typename Scalar>
+std::vector<BezierIntersection<Scalar>> intersectBezierSegment(const std::vector<Point2D<Scalar>>& curve,
+                                                               const Segment2D<Scalar>& segment,
+                                                               const Scalar& epsilon = defaultEpsilon<Scalar>());
+
 }  // namespace plane_geometry
@@ -1 +1,972 @@
-// TODO
\ No newline at end of file
+#include <QElapsedTimer>
+#include <QObject>
+#include <QtTest>
+
+#include "PlaneGeometry/PlaneOperations.h"
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace plane_geometry;
+
+namespace {
+
+std::vector<Point2D<double>> randomPoints(std::size_t count, std::uint32_t seed, double extent = 1.0) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> coordinate(0.0, extent);
+    std::vector<Point2D<double>> points(count);
+    for (auto& point : points) {
+        point = {coordinate(generator), coordinate(generator)};
+    }
+    return points;
+}
+
+// Exact signs on double input: every double is a rational, and rationals do not round.
+using Rational = boost::multiprecision::cpp_rational;
+
+int exactOrientation(const Point2D<double>& a, const Point2D<double>& b, const Point2D<double>& c) {
+    const Rational determinant = (Rational(b.x) - a.x) * (Rational(c.y) - a.y) -
+                                 (Rational(b.y) - a.y) * (Rational(c.x) - a.x);
+    return determinant.sign();
+}
+
+// Whether d lies inside the circle through the CCW triangle abc by more than tolerance, which
+// the tolerance kernel allows on the determinant. Without a tolerance the sign is exact.
+bool insideCircumcircle(const Point2D<double>& a, const Point2D<double>& b, const Point2D<double>& c,
+                        const Point2D<double>& d, double tolerance) {
+    const double adx = a.x - d.x, ady = a.y - d.y;
+    const double bdx = b.x - d.x, bdy = b.y - d.y;
+    const double cdx = c.x - d.x, cdy = c.y - d.y;
+    const double determinant = (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) +
+                               (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy) +
+                               (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+    if (tolerance > 0.0 || std::abs(determinant) > 1e-9) {
+        return determinant > tolerance;
+    }
+    const Rational eadx = Rational(a.x) - d.x, eady = Rational(a.y) - d.y;
+    const Rational ebdx = Rational(b.x) - d.x, ebdy = Rational(b.y) - d.y;
+    const Rational ecdx = Rational(c.x) - d.x, ecdy = Rational(c.y) - d.y;
+    const Rational exact = (eadx * eadx + eady * eady) * (ebdx * ecdy - ecdx * ebdy) +
+                           (ebdx * ebdx + ebdy * ebdy) * (ecdx * eady - eadx * ecdy) +
+                           (ecdx * ecdx + ecdy * ecdy) * (eadx * ebdy - ebdx * eady);
+    return exact.sign() > 0;
+}
+
+bool emptyCircumcircles(const std::vector<Triangle2D<double>>& triangles,
+                        const std::vector<Point2D<double>>& points,
+                        double tolerance = 0.0) {
+    for (Triangle2D<double> triangle : triangles) {
+        const int orientation = exactOrientation(triangle.a, triangle.b, triangle.c);
+        if (orientation == 0) {
+            return false;
+        }
+        if (orientation < 0) {
+            std::swap(triangle.b, triangle.c);
+        }
+        for (const auto& point : points) {
+            if (insideCircumcircle(triangle.a, triangle.b, triangle.c, point, tolerance)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<Triangle2D<double>> meshTriangles(const TriangleMesh<double>& mesh) {
+    std::vector<Triangle2D<double>> triangles;
+    for (const auto& triangle : mesh.triangles) {
+        triangles.push_back({mesh.vertices[triangle[0]], mesh.vertices[triangle[1]], mesh.vertices[triangle[2]]});
+    }
+    return triangles;
+}
+
+double signedArea(const Polygon<double>& polygon) {
+    double area = 0.0;
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+        const auto& a = polygon[i];
+        const auto& b = polygon[(i + 1) % polygon.size()];
+        area += a.x * b.y - b.x * a.y;
+    }
+    return area / 2.0;
+}
+
+double trianglesArea(const std::vector<Triangle2D<double>>& triangles) {
+    double area = 0.0;
+    for (const auto& triangle : triangles) {
+        area += std::abs(signedArea({triangle.a, triangle.b, triangle.c}));
+    }
+    return area;
+}
+
+// Sorted vertex triples, so triangulations can be compared regardless of triangle order.
+std::vector<std::array<double, 6>> normalizedTriangles(const std::vector<Triangle2D<double>>& triangles) {
+    std::vector<std::array<double, 6>> result;
+    for (const auto& triangle : triangles) {
+        std::array<Point2D<double>, 3> corners{triangle.a, triangle.b, triangle.c};
+        std::sort(corners.begin(), corners.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);
+        });
+        result.push_back({corners[0].x, corners[0].y, corners[1].x, corners[1].y, corners[2].x, corners[2].y});
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Area enclosed by the outers minus the holes, also checking that outers are CCW and holes CW.
+double regionArea(const BooleanResult<double>& region) {
+    double area = 0.0;
+    for (const auto& outer : region.outers) {
+        const double outerArea = signedArea(outer);
+        if (outerArea <= 0.0) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        area += outerArea;
+    }
+    for (const auto& hole : region.holes) {
+        const double holeArea = signedArea(hole);
+        if (holeArea >= 0.0) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        area += holeArea;
+    }
+    return area;
+}
+
+Polygon<double> rectangle(double minX, double minY, double maxX, double maxY) {
+    return {{minX, minY}, {maxX, minY}, {maxX, maxY}, {minX, maxY}};
+}
+
+Polygon<double> regularPolygon(std::size_t count, double radius, double phase, Point2D<double> centre) {
+    Polygon<double> polygon;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double angle = phase + 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(count);
+        polygon.push_back({centre.x + radius * std::cos(angle), centre.y + radius * std::sin(angle)});
+    }
+    return polygon;
+}
+
+// Sutherland-Hodgman clip of a polygon by a CCW convex one.
+Polygon<double> clipConvex(Polygon<double> subject, const Polygon<double>& clip) {
+    for (std::size_t i = 0; i < clip.size() && !subject.empty(); ++i) {
+        const auto& a = clip[i];
+        const auto& b = clip[(i + 1) % clip.size()];
+        const auto side = [&](const Point2D<double>& p) {
+            return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+        };
+        Polygon<double> output;
+        for (std::size_t j = 0; j < subject.size(); ++j) {
+            const auto& p = subject[j];
+            const auto& q = subject[(j + 1) % subject.size()];
+            const double sp = side(p);
+            const double sq = side(q);
+            if (sp >= 0.0) {
+                output.push_back(p);
+            }
+            if ((sp >= 0.0) != (sq >= 0.0)) {
+                const double t = sp / (sp - sq);
+                output.push_back({p.x + t * (q.x - p.x), p.y + t * (q.y - p.y)});
+            }
+        }
+        subject = std::move(output);
+    }
+    return subject;
+}
+
+// Star-shaped simple polygon with the given number of vertices around (0.5, 0.5).
+Polygon<double> starPolygon(std::size_t count, std::uint32_t seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> radius(0.1, 0.45);
+    Polygon<double> polygon;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(count);
+        const double r = radius(generator);
+        polygon.push_back({0.5 + r * std::cos(angle), 0.5 + r * std::sin(angle)});
+    }
+    return polygon;
+}
+
+// Random points plus every vertex and edge midpoint of the polygon, so that all three answers occur.
+std::vector<Point2D<double>> locationQueries(const Polygon<double>& polygon, std::size_t count, std::uint32_t seed) {
+    std::vector<Point2D<double>> queries = randomPoints(count, seed);
+    for (std::size_t i = 0; i < polygon.size(); ++i) {
+        const auto& a = polygon[i];
+        const auto& b = polygon[(i + 1) % polygon.size()];
+        queries.push_back(a);
+        queries.push_back({(a.x + b.x) / 2.0, (a.y + b.y) / 2.0});
+    }
+    return queries;
+}
+
+double distanceToSegment(const Point2D<double>& point, const Point2D<double>& a, const Point2D<double>& b) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double lengthSquared = dx * dx + dy * dy;
+    double t = lengthSquared > 0.0 ? ((point.x - a.x) * dx + (point.y - a.y) * dy) / lengthSquared : 0.0;
+    t = std::clamp(t, 0.0, 1.0);
+    return std::hypot(point.x - (a.x + t * dx), point.y - (a.y + t * dy));
+}
+
+}  // namespace
+
+class PlaneGeometryTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void filtered_orientation_is_exact();
+    void filtered_incircle_is_exact();
+    void delaunay_empty_circumcircle_and_hull_area();
+    void delaunay_welds_near_duplicates();
+    void delaunay_seed_is_reproducible();
+    void parallel_delaunay_matches_sequential();
+    void delaunay_mesh_neighbors();
+    void dynamic_delaunay_insert_remove_move();
+    void constrained_delaunay_keeps_constraints();
+    void intersect_all_endpoint_near_vertical();
+    void intersect_all_matches_brute_force();
+    void intersect_all_tolerance_wide_layer();
+    void convex_intersection_matches_clipping();
+    void convex_union_welds_near_vertices();
+    void convex_difference_shared_edges();
+    void boolean_operation_areas_with_holes();
+    void union_all_grid();
+    void xor_areas();
+    void boolean_overlay_matches_operations();
+    void convex_locator_matches_scalar();
+    void convex_locator_clockwise_near_edge();
+    void polygon_locator_matches_scalar();
+    void polygon_locator_long_edge_boundary();
+    void batch_locate_matches_scalar();
+    void trapezoidal_map_locates_mesh_triangles();
+    void trapezoidal_map_outer_boundary();
+    void bezier_curve_matches_evaluate();
+    void uniform_sampler_matches_sample_bezier();
+    void flatten_stays_within_tolerance();
+    void batch_cubic_matches_scalar();
+    void bezier_known_intersections();
+};
+
+void PlaneGeometryTests::filtered_orientation_is_exact() {
+    // Points a few ulps around a long diagonal, where the double determinant is all rounding.
+    const Segment2D<double> segment{{0.5, 0.5}, {12.0, 12.0}};
+    for (int i = 0; i < 32; ++i) {
+        for (int j = 0; j < 32; ++j) {
+            Point2D<double> point{0.5, 0.5};
+            for (int k = 0; k < i; ++k) {
+                point.x = std::nextafter(point.x, 1.0);
+            }
+            for (int k = 0; k < j; ++k) {
+                point.y = std::nextafter(point.y, 1.0);
+            }
+            const int expected = exactOrientation(segment.start, segment.end, point);
+            const Orientation orientation =
+                classifyPointRelativeToSegment(segment, point, 0.0, PredicateKernel::Filtered);
+            if (expected == 0) {
+                QCOMPARE(orientation, Orientation::OnSegment);
+            } else {
+                QCOMPARE(orientation, expected > 0 ? Orientation::Left : Orientation::Right);
+            }
+        }
+    }
+
+    const Segment2D<ExactScalar> exactSegment{{ExactScalar("0.1"), ExactScalar("0.1")}, {ExactScalar("7"), ExactScalar("7")}};
+    const Point2D<ExactScalar> onLine{ExactScalar("3.3"), ExactScalar("3.3")};
+    const Point2D<ExactScalar> above{ExactScalar("3.3"), ExactScalar("3.3") + ExactScalar("1e-40")};
+    QCOMPARE(classifyPointRelativeToSegment(exactSegment, onLine, ExactScalar(0), PredicateKernel::Filtered),
+             Orientation::OnSegment);
+    QCOMPARE(classifyPointRelativeToSegment(exactSegment, above, ExactScalar(0), PredicateKernel::Filtered),
+             Orientation::Left);
+}
+
+void PlaneGeometryTests::filtered_incircle_is_exact() {
+    // Points on the unit circle rounded to double, so that every four are nearly cocircular.
+    std::vector<Point2D<double>> points;
+    for (int i = 0; i < 64; ++i) {
+        const double angle = 2.0 * M_PI * i / 64.0;
+        points.push_back({0.5 + 0.5 * std::cos(angle), 0.5 + 0.5 * std::sin(angle)});
+    }
+    const auto triangles = delaunayTriangulation(points, PredicateKernel::Filtered);
+    QCOMPARE(static_cast<int>(triangles.size()), 62);
+    QVERIFY(emptyCircumcircles(triangles, points));
+}
+
+void PlaneGeometryTests::delaunay_empty_circumcircle_and_hull_area() {
+    for (const PredicateKernel kernel : {PredicateKernel::Tolerance, PredicateKernel::Filtered}) {
+        const auto points = randomPoints(400, 7);
+        const auto triangles = delaunayTriangulation(points, kernel);
+        QVERIFY(emptyCircumcircles(triangles, points, kernel == PredicateKernel::Tolerance ? 1e-9 : 0.0));
+
+        const auto hull = computeConvexHull(points, kernel);
+        QVERIFY(std::abs(trianglesArea(triangles) - std::abs(signedArea(hull))) < 1e-12);
+        // Euler: 2n - 2 - h triangles for n points with h on the hull.
+        QCOMPARE(triangles.size(), 2 * points.size() - 2 - hull.size());
+    }
+
+    // Grid points are all cocircular in fours.
+    std::vector<Point2D<double>> grid;
+    for (int i = 0; i < 12; ++i) {
+        for (int j = 0; j < 12; ++j) {
+            grid.push_back({static_cast<double>(i), static_cast<double>(j)});
+        }
+    }
+    const auto triangles = delaunayTriangulation(grid, PredicateKernel::Filtered);
+    QCOMPARE(static_cast<int>(triangles.size()), 2 * 11 * 11);
+    QCOMPARE(trianglesArea(triangles), 121.0);
+}
+
+void PlaneGeometryTests::delaunay_welds_near_duplicates() {
+    // Each point has a copy less than epsilon away, and a point just over epsilon to the right
+    // but lower down, which an epsilon-tolerant lexicographic order puts between the two.
+    std::vector<Point2D<double>> points;
+    for (const auto& point : randomPoints(200, 5)) {
+        points.push_back(point);
+        points.push_back({point.x + 1.5e-9, point.y - 1e-3});
+        points.push_back({point.x + 0.8e-9, point.y + 1e-12});
+    }
+    const auto triangles = delaunayTriangulation(points);
+    std::vector<Point2D<double>> used;
+    for (const auto& triangle : triangles) {
+        used.insert(used.end(), {triangle.a, triangle.b, triangle.c});
+    }
+    std::sort(used.begin(), used.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);
+    });
+    used.erase(std::unique(used.begin(), used.end(), [](const auto& lhs, const auto& rhs) {
+                   return lhs.x == rhs.x && lhs.y == rhs.y;
+               }),
+               used.end());
+    QCOMPARE(static_cast<int>(used.size()), 400);
+    for (std::size_t i = 0; i < used.size(); ++i) {
+        for (std::size_t j = i + 1; j < used.size() && used[j].x - used[i].x <= 1e-9; ++j) {
+            QVERIFY(std::abs(used[j].y - used[i].y) > 1e-9);
+        }
+    }
+}
+
+void PlaneGeometryTests::delaunay_seed_is_reproducible() {
+    const auto points = randomPoints(500, 3);
+    DelaunayOptions options;
+    options.kernel = PredicateKernel::Filtered;
+    options.seed = 42;
+    const auto first = delaunayTriangulation(points, options);
+    const auto second = delaunayTriangulation(points, options);
+    QCOMPARE(static_cast<int>(first.size()), static_cast<int>(second.size()));
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        QCOMPARE(first[i].a.x, second[i].a.x);
+        QCOMPARE(first[i].b.y, second[i].b.y);
+        QCOMPARE(first[i].c.x, second[i].c.x);
+    }
+
+    // Points in general position have one Delaunay triangulation, whatever the insertion order.
+    options.seed = 7;
+    QVERIFY(normalizedTriangles(delaunayTriangulation(points, options)) == normalizedTriangles(first));
+    QVERIFY(emptyCircumcircles(first, points));
+}
+
+void PlaneGeometryTests::parallel_delaunay_matches_sequential() {
+    for (const std::size_t count : {3u, 10u, 1000u, 5000u}) {
+        const auto points = randomPoints(count, static_cast<std::uint32_t>(count));
+        DelaunayOptions options;
+        options.kernel = PredicateKernel::Filtered;
+        const auto sequential = delaunayTriangulation(points, options);
+        options.parallel = true;
+        for (const unsigned threads : {1u, 4u}) {
+            options.threadCount = threads;
+            const auto parallel = delaunayTriangulation(points, options);
+            QVERIFY(normalizedTriangles(parallel) == normalizedTriangles(sequential));
+        }
+    }
+
+    // On a grid the cocircular ties may be broken either way, but the result stays Delaunay.
+    std::vector<Point2D<double>> grid;
+    for (int i = 0; i < 20; ++i) {
+        for (int j = 0; j < 20; ++j) {
+            grid.push_back({i / 19.0, j / 19.0});
+        }
+    }
+    DelaunayOptions options;
+    options.parallel = true;
+    options.threadCount = 4;
+    const auto triangles = delaunayTriangulation(grid, options);
+    QCOMPARE(static_cast<int>(triangles.size()), 2 * 19 * 19);
+    QVERIFY(emptyCircumcircles(triangles, grid));
+}
+
+void PlaneGeometryTests::delaunay_mesh_neighbors() {
+    const auto points = randomPoints(300, 9);
+    const TriangleMesh<double> mesh = delaunayTriangulationMesh(points);
+    QCOMPARE(mesh.neighbors.size(), mesh.triangles.size());
+    QVERIFY(emptyCircumcircles(meshTriangles(mesh), points, 1e-9));
+
+    std::size_t hullEdges = 0;
+    for (std::size_t t = 0; t < mesh.triangles.size(); ++t) {
+        const auto& triangle = mesh.triangles[t];
+        QCOMPARE(exactOrientation(mesh.vertices[triangle[0]], mesh.vertices[triangle[1]], mesh.vertices[triangle[2]]), 1);
+        for (std::size_t i = 0; i < 3; ++i) {
+            const std::uint32_t neighbor = mesh.neighbors[t][i];
+            if (neighbor == TriangleMesh<double>::NoNeighbor) {
+                ++hullEdges;
+                continue;
+            }
+            // The neighbour holds the same edge the other way round and points back.
+            const std::uint32_t from = triangle[(i + 1) % 3];
+            const std::uint32_t to = triangle[(i + 2) % 3];
+            const auto& other = mesh.triangles[neighbor];
+            bool found = false;
+            for (std::size_t j = 0; j < 3; ++j) {
+                if (other[(j + 1) % 3] == to && other[(j + 2) % 3] == from) {
+                    QCOMPARE(mesh.neighbors[neighbor][j], static_cast<std::uint32_t>(t));
+                    found = true;
+                }
+            }
+            QVERIFY(found);
+        }
+    }
+    QCOMPARE(hullEdges, computeConvexHull(points).size());
+}
+
+void PlaneGeometryTests::dynamic_delaunay_insert_remove_move() {
+    const auto livePoints = [](const TriangleMesh<double>& mesh, const std::vector<std::uint32_t>& ids) {
+        std::vector<Point2D<double>> points;
+        for (const std::uint32_t id : ids) {
+            if (id != DynamicDelaunayTriangulation<double>::InvalidVertex) {
+                points.push_back(mesh.vertices[id]);
+            }
+        }
+        return points;
+    };
+
+    DynamicDelaunayTriangulation<double> triangulation(PredicateKernel::Filtered);
+    const auto points = randomPoints(300, 21);
+    std::vector<std::uint32_t> ids;
+    for (const auto& point : points) {
+        ids.push_back(triangulation.insert(point));
+        QVERIFY(ids.back() != DynamicDelaunayTriangulation<double>::InvalidVertex);
+    }
+    QCOMPARE(triangulation.insert(points.front()), DynamicDelaunayTriangulation<double>::InvalidVertex);
+    QCOMPARE(triangulation.vertexCount(), points.size());
+    TriangleMesh<double> mesh = triangulation.mesh();
+    QVERIFY(emptyCircumcircles(meshTriangles(mesh), points));
+
+    for (std::size_t i = 0; i < ids.size(); i += 3) {
+        QVERIFY(triangulation.remove(ids[i]));
+        ids[i] = DynamicDelaunayTriangulation<double>::InvalidVertex;
+    }
+    mesh = triangulation.mesh();
+    auto live = livePoints(mesh, ids);
+    QCOMPARE(triangulation.vertexCount(), live.size());
+    QVERIFY(emptyCircumcircles(meshTriangles(mesh), live));
+    QCOMPARE(meshTriangles(mesh).size(), 2 * live.size() - 2 - computeConvexHull(live).size());
+
+    std::mt19937 generator(4);
+    std::uniform_real_distribution<double> step(-0.05, 0.05);
+    for (std::size_t i = 1; i < ids.size(); i += 3) {
+        const Point2D<double> target{mesh.vertices[ids[i]].x + step(generator), mesh.vertices[ids[i]].y + step(generator)};
+        QVERIFY(triangulation.move(ids[i], target));
+        mesh = triangulation.mesh();
+    }
+    live = livePoints(mesh, ids);
+    QVERIFY(emptyCircumcircles(meshTriangles(mesh), live));
+
+    // Moving onto another vertex is refused and leaves the vertex in place.
+    const Point2D<double> before = mesh.vertices[ids[1]];
+    QVERIFY(!triangulation.move(ids[1], mesh.vertices[ids[2]]));
+    QCOMPARE(triangulation.mesh().vertices[ids[1]].x, before.x);
+    QCOMPARE(triangulation.mesh().vertices[ids[1]].y, before.y);
+}
+
+void PlaneGeometryTests::constrained_delaunay_keeps_constraints() {
+    std::vector<Point2D<double>> points = randomPoints(200, 13);
+    const std::uint32_t first = static_cast<std::uint32_t>(points.size());
+    points.insert(points.end(), {{0.05, 0.1}, {0.95, 0.3}, {0.1, 0.9}, {0.9, 0.05}, {0.02, 0.5}, {0.98, 0.52}});
+    // Long constraints that cross many Delaunay edges; the third crosses the first.
+    const std::vector<std::array<std::uint32_t, 2>> constraints{{first, first + 1}, {first + 4, first + 5}};
+
+    const TriangleMesh<double> mesh = constrainedDelaunayTriangulation(points, constraints, PredicateKernel::Filtered);
+    QVERIFY(std::abs(trianglesArea(meshTriangles(mesh)) - std::abs(signedArea(computeConvexHull(points)))) < 1e-12);
+    for (const auto& constraint : constraints) {
+        // Walk the chain of mesh edges lying on the constraint from one end to the other.
+        std::uint32_t current = constraint[0];
+        for (std::size_t steps = 0; current != constraint[1]; ++steps) {
+            QVERIFY(steps < points.size());
+            std::uint32_t next = current;
+            double progress = 0.0;
+            const auto& a = points[constraint[0]];
+            const auto& b = points[constraint[1]];
+            for (const auto& triangle : mesh.triangles) {
+                for (std::size_t i = 0; i < 3; ++i) {
+                    if (triangle[i] != current) {
+                        continue;
+                    }
+                    for (const std::uint32_t candidate : {triangle[(i + 1) % 3], triangle[(i + 2) % 3]}) {
+                        const auto& p = points[candidate];
+                        const double along = ((p.x - a.x) * (b.x - a.x) + (p.y - a.y) * (b.y - a.y)) -
+                                             ((points[current].x - a.x) * (b.x - a.x) + (points[current].y - a.y) * (b.y - a.y));
+                        if (exactOrientation(a, b, p) == 0 && along > progress) {
+                            next = candidate;
+                            progress = along;
+                        }
+                    }
+                }
+            }
+            QVERIFY(next != current);
+            current = next;
+        }
+    }
+
+    // A square with a square hole: the hole stays empty.
+    BooleanResult<double> framed;
+    framed.outers.push_back(rectangle(0.0, 0.0, 4.0, 4.0));
+    framed.holes.push_back(rectangle(1.0, 1.0, 3.0, 3.0));
+    QCOMPARE(trianglesArea(meshTriangles(triangulateRegion(framed))), 12.0);
+
+    std::vector<std::array<std::uint32_t, 2>> crossing{{first, first + 1}, {first + 2, first + 3}};
+    bool thrown = false;
+    try {
+        constrainedDelaunayTriangulation(points, crossing, PredicateKernel::Filtered);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    QVERIFY(thrown);
+}
+
+void PlaneGeometryTests::intersect_all_endpoint_near_vertical() {
+    // The horizontal segment ends within epsilon of the vertical one, before the sweep reaches it.
+    const std::vector<Segment2D<double>> segments{{{0.0, 0.0}, {0.0, 1.0}}, {{-1.0, 0.5}, {-5e-10, 0.5}}};
+    QCOMPARE(intersectSegments(segments[0], segments[1], 1e-9).type, IntersectionType::Point);
+
+    const auto pairs = intersectAllSegments(segments, 1e-9);
+    QCOMPARE(static_cast<int>(pairs.size()), 1);
+    QCOMPARE(pairs.front().first, 0u);
+    QCOMPARE(pairs.front().second, 1u);
+    QCOMPARE(pairs.front().result.type, IntersectionType::Point);
+}
+
+void PlaneGeometryTests::intersect_all_matches_brute_force() {
+    // Endpoints on a coarse grid give shared endpoints, collinear overlaps and verticals.
+    std::mt19937 generator(17);
+    std::uniform_int_distribution<int> coordinate(0, 12);
+    std::vector<Segment2D<double>> segments;
+    while (segments.size() < 300) {
+        const Segment2D<double> segment{{coordinate(generator) / 4.0, coordinate(generator) / 4.0},
+                                        {coordinate(generator) / 4.0, coordinate(generator) / 4.0}};
+        if (segment.start.x != segment.end.x || segment.start.y != segment.end.y) {
+            segments.push_back(segment);
+        }
+    }
+    for (const PredicateKernel kernel : {PredicateKernel::Tolerance, PredicateKernel::Filtered}) {
+        const auto pairs = intersectAllSegments(segments, 1e-9, kernel);
+        std::size_t next = 0;
+        for (std::uint32_t i = 0; i < segments.size(); ++i) {
+            for (std::uint32_t j = i + 1; j < segments.size(); ++j) {
+                const auto expected = intersectSegments(segments[i], segments[j], 1e-9, kernel);
+                if (expected.type == IntersectionType::None) {
+                    continue;
+                }
+                QVERIFY(next < pairs.size());
+                QCOMPARE(pairs[next].first, i);
+                QCOMPARE(pairs[next].second, j);
+                QCOMPARE(pairs[next].result.type, expected.type);
+                ++next;
+            }
+        }
+        QCOMPARE(next, pairs.size());
+    }
+}
+
+void PlaneGeometryTests::intersect_all_tolerance_wide_layer() {
+    // Short segments across a layer a million wide and one segment spanning it: the probes around
+    // the short segments must stay short, or every probe meets every other.
+    std::mt19937 generator(23);
+    std::uniform_real_distribution<double> x(0.0, 1e6);
+    std::uniform_real_distribution<double> y(10.0, 20.0);
+    std::vector<Segment2D<double>> segments{{{0.0, 0.0}, {1e6, 5.0}}};
+    for (int i = 0; i < 50000; ++i) {
+        const Point2D<double> start{x(generator), y(generator)};
+        segments.push_back({start, {start.x + 1e-3, start.y + 1e-3}});
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const auto filtered = intersectAllSegments(segments, 1e-9, PredicateKernel::Filtered);
+    const qint64 filteredTime = timer.restart();
+    const auto tolerance = intersectAllSegments(segments, 1e-9, PredicateKernel::Tolerance);
+    const qint64 toleranceTime = timer.elapsed();
+    QCOMPARE(tolerance.size(), filtered.size());
+    QVERIFY(toleranceTime < 10 * filteredTime + 2000);
+}
+
+void PlaneGeometryTests::convex_intersection_matches_clipping() {
+    for (int i = 0; i < 50; ++i) {
+        const Polygon<double> first = regularPolygon(3 + i % 9, 1.0, 0.1 * i, {0.0, 0.0});
+        const Polygon<double> second = regularPolygon(4 + i % 7, 0.8, 0.3 * i, {0.04 * i - 1.0, 0.5});
+        const Polygon<double> result = intersectConvexPolygons(first, second);
+        const double expected = std::abs(signedArea(clipConvex(first, second)));
+        QVERIFY(std::abs(std::abs(signedArea(result)) - expected) < 1e-9);
+    }
+
+    // Containment, a shared edge and disjoint squares.
+    const Polygon<double> square = rectangle(0.0, 0.0, 4.0, 4.0);
+    QCOMPARE(std::abs(signedArea(intersectConvexPolygons(square, rectangle(1.0, 1.0, 2.0, 3.0)))), 2.0);
+    QCOMPARE(std::abs(signedArea(intersectConvexPolygons(square, rectangle(4.0, 0.0, 6.0, 4.0)))), 0.0);
+    QVERIFY(intersectConvexPolygons(square, rectangle(5.0, 5.0, 6.0, 6.0)).empty());
+}
+
+void PlaneGeometryTests::convex_union_welds_near_vertices() {
+    // The squares share an edge whose corners differ by far less than epsilon.
+    const Polygon<double> left = rectangle(0.0, 0.0, 1.0, 1.0);
+    const Polygon<double> right{{1.0 + 1e-12, -1e-12}, {2.0, 0.0}, {2.0, 1.0}, {1.0 - 1e-12, 1.0 + 1e-12}};
+    const BooleanResult<double> result = unionConvexPolygons(left, right);
+    QCOMPARE(static_cast<int>(result.outers.size()), 1);
+    QVERIFY(result.holes.empty());
+    QVERIFY(std::abs(regionArea(result) - 2.0) < 1e-9);
+}
+
+void PlaneGeometryTests::convex_difference_shared_edges() {
+    const Polygon<double> strip = rectangle(0.0, 0.0, 2.0, 1.0);
+    BooleanResult<double> result = differenceConvexPolygons(strip, rectangle(1.0, 0.0, 2.0, 1.0));
+    QCOMPARE(static_cast<int>(result.outers.size()), 1);
+    QCOMPARE(regionArea(result), 1.0);
+
+    result = differenceConvexPolygons(strip, strip);
+    QVERIFY(result.empty());
+
+    result = unionConvexPolygons(strip, rectangle(2.0, 0.0, 3.0, 1.0));
+    QCOMPARE(static_cast<int>(result.outers.size()), 1);
+    QCOMPARE(regionArea(result), 3.0);
+}
+
+void PlaneGeometryTests::boolean_operation_areas_with_holes() {
+    // A 4x4 square with a 2x2 hole, against a square covering its right half.
+    BooleanResult<double> framed;
+    framed.outers.push_back(rectangle(0.0, 0.0, 4.0, 4.0));
+    framed.holes.push_back(rectangle(1.0, 1.0, 3.0, 3.0));
+    BooleanResult<double> right;
+    right.outers.push_back(rectangle(2.0, 0.0, 6.0, 4.0));
+
+    QCOMPARE(regionArea(booleanOperation(framed, right, BooleanOperation::Intersection)), 6.0);
+    QCOMPARE(regionArea(booleanOperation(framed, right, BooleanOperation::Union)), 22.0);
+    QCOMPARE(regionArea(booleanOperation(framed, right, BooleanOperation::Difference)), 6.0);
+    QCOMPARE(regionArea(booleanOperation(right, framed, BooleanOperation::Difference)), 10.0);
+
+    // Taking out the middle leaves a hole in the result.
+    const BooleanResult<double> hollow = booleanOperation(rectangle(0.0, 0.0, 4.0, 4.0), rectangle(1.0, 1.0, 3.0, 3.0),
+                                                          BooleanOperation::Difference);
+    QCOMPARE(static_cast<int>(hollow.outers.size()), 1);
+    QCOMPARE(static_cast<int>(hollow.holes.size()), 1);
+    QCOMPARE(regionArea(hollow), 12.0);
+
+    // Non-convex: an L against a square over its corner, in clockwise order.
+    const Polygon<double> lShape{{0.0, 0.0}, {3.0, 0.0}, {3.0, 1.0}, {1.0, 1.0}, {1.0, 3.0}, {0.0, 3.0}};
+    const Polygon<double> clockwise{{0.5, 0.5}, {0.5, 2.0}, {2.0, 2.0}, {2.0, 0.5}};
+    QCOMPARE(regionArea(booleanOperation(lShape, clockwise, BooleanOperation::Intersection)), 1.25);
+    QCOMPARE(regionArea(booleanOperation(lShape, clockwise, BooleanOperation::Union)), 6.0);
+
+    for (const PredicateKernel kernel : {PredicateKernel::Tolerance, PredicateKernel::Filtered}) {
+        const Polygon<double> first = starPolygon(40, 1);
+        const Polygon<double> second = starPolygon(50, 2);
+        const double a = std::abs(signedArea(first));
+        const double b = std::abs(signedArea(second));
+        const double both = regionArea(booleanOperation(first, second, BooleanOperation::Intersection, 1e-9, kernel));
+        const double either = regionArea(booleanOperation(first, second, BooleanOperation::Union, 1e-9, kernel));
+        const double only = regionArea(booleanOperation(first, second, BooleanOperation::Difference, 1e-9, kernel));
+        QVERIFY(std::abs(either - (a + b - both)) < 1e-12);
+        QVERIFY(std::abs(only - (a - both)) < 1e-12);
+    }
+}
+
+void PlaneGeometryTests::union_all_grid() {
+    // Six by six unit squares 0.75 apart overlap their neighbours into one 4.75 square.
+    std::vector<Polygon<double>> squares;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            squares.push_back(rectangle(0.75 * i, 0.75 * j, 0.75 * i + 1.0, 0.75 * j + 1.0));
+        }
+    }
+    for (const unsigned threads : {1u, 4u}) {
+        const BooleanResult<double> result = unionAll(squares, 1e-9, PredicateKernel::Tolerance, threads);
+        QCOMPARE(static_cast<int>(result.outers.size()), 1);
+        QVERIFY(result.holes.empty());
+        QVERIFY(std::abs(regionArea(result) - 4.75 * 4.75) < 1e-12);
+    }
+
+    // A ring of squares around an empty middle leaves a hole.
+    std::vector<Polygon<double>> ring;
+    for (int i = 0; i < 4; ++i) {
+        ring.push_back(rectangle(i, 0.0, i + 1.0, 1.0));
+        ring.push_back(rectangle(i, 3.0, i + 1.0, 4.0));
+        ring.push_back(rectangle(0.0, i, 1.0, i + 1.0));
+        ring.push_back(rectangle(3.0, i, 4.0, i + 1.0));
+    }
+    const BooleanResult<double> result = unionAll(ring);
+    QCOMPARE(static_cast<int>(result.outers.size()), 1);
+    QCOMPARE(static_cast<int>(result.holes.size()), 1);
+    QVERIFY(std::abs(regionArea(result) - 12.0) < 1e-12);
+    QVERIFY(unionAll(std::vector<Polygon<double>>{}).empty());
+}
+
+void PlaneGeometryTests::xor_areas() {
+    const Polygon<double> square = rectangle(0.0, 0.0, 4.0, 4.0);
+    BooleanResult<double> result = xorPolygons(square, rectangle(2.0, 2.0, 6.0, 6.0));
+    QCOMPARE(static_cast<int>(result.outers.size()), 2);
+    QCOMPARE(regionArea(result), 24.0);
+
+    result = xorPolygons(square, rectangle(1.0, 1.0, 3.0, 3.0));
+    QCOMPARE(static_cast<int>(result.holes.size()), 1);
+    QCOMPARE(regionArea(result), 12.0);
+
+    QVERIFY(xorPolygons(square, square).empty());
+
+    const Polygon<double> first = starPolygon(30, 3);
+    const Polygon<double> second = starPolygon(35, 4);
+    const double both = regionArea(booleanOperation(first, second, BooleanOperation::Intersection));
+    const double expected = std::abs(signedArea(first)) + std::abs(signedArea(second)) - 2.0 * both;
+    QVERIFY(std::abs(regionArea(xorPolygons(first, second)) - expected) < 1e-12);
+    QVERIFY(std::abs(regionArea(booleanOperation(first, second, BooleanOperation::Xor)) - expected) < 1e-12);
+}
+
+void PlaneGeometryTests::boolean_overlay_matches_operations() {
+    const Polygon<double> first = starPolygon(60, 5);
+    const Polygon<double> second = starPolygon(45, 6);
+    const BooleanOverlay<double> overlay(first, second);
+    for (const BooleanOperation operation : {BooleanOperation::Union, BooleanOperation::Intersection,
+                                             BooleanOperation::Difference, BooleanOperation::Xor}) {
+        const BooleanResult<double> shared = overlay.compute(operation);
+        const BooleanResult<double> single = booleanOperation(first, second, operation);
+        QCOMPARE(shared.outers.size(), single.outers.size());
+        QCOMPARE(shared.holes.size(), single.holes.size());
+        QCOMPARE(regionArea(shared), regionArea(single));
+    }
+
+    // The convex entry points run through the same overlay.
+    const Polygon<double> square = rectangle(0.0, 0.0, 2.0, 2.0);
+    const Polygon<double> shifted = rectangle(1.0, 1.0, 3.0, 3.0);
+    QCOMPARE(regionArea(unionConvexPolygons(square, shifted)), 7.0);
+    QCOMPARE(regionArea(differenceConvexPolygons(square, shifted)), 3.0);
+}
+
+void PlaneGeometryTests::convex_locator_matches_scalar() {
+    for (const PredicateKernel kernel : {PredicateKernel::Tolerance, PredicateKernel::Filtered}) {
+        for (const bool clockwise : {false, true}) {
+            Polygon<double> polygon = regularPolygon(37, 0.4, 0.2, {0.5, 0.5});
+            if (clockwise) {
+                std::reverse(polygon.begin(), polygon.end());
+            }
+            const ConvexPolygonLocator<double> locator(polygon, 1e-9, kernel);
+            for (const auto& point : locationQueries(polygon, 2000, 31)) {
+                QCOMPARE(locator.locate(point), locatePointInConvexPolygon(polygon, point, 1e-9, kernel));
+            }
+        }
+    }
+}
+
+void PlaneGeometryTests::convex_locator_clockwise_near_edge() {
+    const Polygon<double> hull{{5.0, 8.0}, {8.0, 3.0}, {1.0, 1.0}, {0.0, 3.0}, {1.0, 6.0}};
+    const Point2D<double> point{1.0, 0.9999999995};
+    QCOMPARE(ConvexPolygonLocator<double>(hull).locate(point), locatePointInConvexPolygon(hull, point));
+}
+
+void PlaneGeometryTests::polygon_locator_matches_scalar() {
+    for (const PredicateKernel kernel : {PredicateKernel::Tolerance, PredicateKernel::Filtered}) {
+        const Polygon<double> polygon = starPolygon(300, 8);
+        const PolygonLocator<double> locator(polygon, 1e-9, kernel);
+        for (const auto& point : locationQueries(polygon, 3000, 33)) {
+            QCOMPARE(locator.locate(point), locatePointInPolygon(polygon, point, 1e-9, kernel));
+        }
+    }
+
+    // Edges crossing each other are rejected.
+    const Polygon<double> bowtie{{0.0, 0.0}, {1.0, 1.0}, {1.0, 0.0}, {0.0, 1.0}};
+    bool thrown = false;
+    try {
+        PolygonLocator<double> locator(bowtie);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    QVERIFY(thrown);
+}
+
+void PlaneGeometryTests::polygon_locator_long_edge_boundary() {
+    // The bottom edge is long enough for the tolerance boundary test to reach far above epsilon.
+    Polygon<double> polygon{{0.0, 0.0}, {1e6, 0.0}};
+    for (int i = 100000; i > 0; --i) {
+        polygon.push_back({1e6 * i / 100001.0, i % 2 == 0 ? 10.0 : 9.0});
+    }
+    const Point2D<double> point{500000.3, 5e-4};
+    QCOMPARE(locatePointInPolygon(polygon, point), PointClassification::OnBoundary);
+    QCOMPARE(PolygonLocator<double>(polygon).locate(point), PointClassification::OnBoundary);
+}
+
+void PlaneGeometryTests::batch_locate_matches_scalar() {
+    for (const PredicateKernel kernel : {PredicateKernel::Tolerance, PredicateKernel::Filtered}) {
+        // Odd counts leave a tail after the last full vector.
+        for (const std::size_t count : {3u, 7u, 201u}) {
+            const Polygon<double> polygon = starPolygon(count, static_cast<std::uint32_t>(count));
+            const auto queries = locationQueries(polygon, 1001, 35);
+            const auto batch = locatePointsInPolygon(polygon, queries, 1e-9, kernel);
+            QCOMPARE(batch.size(), queries.size());
+            for (std::size_t i = 0; i < queries.size(); ++i) {
+                QCOMPARE(batch[i], locatePointInPolygon(polygon, queries[i], 1e-9, kernel));
+            }
+        }
+    }
+    QVERIFY(locatePointsInPolygon(starPolygon(10, 1), std::vector<Point2D<double>>{}).empty());
+}
+
+void PlaneGeometryTests::trapezoidal_map_locates_mesh_triangles() {
+    const auto points = randomPoints(500, 37);
+    const TriangleMesh<double> mesh = delaunayTriangulationMesh(points);
+    const TrapezoidalMap<double> map(mesh, 1u);
+    const auto hull = computeConvexHull(points);
+    for (const auto& point : randomPoints(5000, 39)) {
+        const std::uint32_t face = map.locate(point);
+        if (locatePointInConvexPolygon(hull, point, 0.0, PredicateKernel::Filtered) == PointClassification::Outside) {
+            QCOMPARE(face, TrapezoidalMap<double>::NoFace);
+            continue;
+        }
+        QVERIFY(face < mesh.triangles.size());
+        const auto& triangle = mesh.triangles[face];
+        for (std::size_t i = 0; i < 3; ++i) {
+            QVERIFY(exactOrientation(mesh.vertices[triangle[i]], mesh.vertices[triangle[(i + 1) % 3]], point) >= 0);
+        }
+    }
+}
+
+void PlaneGeometryTests::trapezoidal_map_outer_boundary() {
+    const std::vector<Polygon<double>> faces{{{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}}, {{0.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}}};
+    const TrapezoidalMap<double> map(faces, 1u);
+    QCOMPARE(map.locate({0.5, 0.0}), 0u);
+    QCOMPARE(map.locate({1.0, 0.5}), 0u);
+    QCOMPARE(map.locate({0.5, 1.0}), 1u);
+    QCOMPARE(map.locate({0.0, 0.5}), 1u);
+    for (const Point2D<double> corner : {Point2D<double>{0.0, 0.0}, Point2D<double>{1.0, 0.0},
+                                         Point2D<double>{1.0, 1.0}, Point2D<double>{0.0, 1.0}}) {
+        QVERIFY(map.locate(corner) != TrapezoidalMap<double>::NoFace);
+    }
+    QCOMPARE(map.locate({0.5, -1e-12}), TrapezoidalMap<double>::NoFace);
+}
+
+void PlaneGeometryTests::bezier_curve_matches_evaluate() {
+    const std::array<Point2D<double>, 4> control{{{0.0, 0.0}, {0.3, 1.7}, {1.1, -0.4}, {2.0, 1.0}}};
+    const std::vector<Point2D<double>> controlVector(control.begin(), control.end());
+    const BezierCurve<double, 3> curve(control);
+    for (int i = 0; i <= 100; ++i) {
+        const double t = i / 100.0;
+        const Point2D<double> expected = evaluateBezier(controlVector, t);
+        QCOMPARE(curve.evaluate(t).x, expected.x);
+        QCOMPARE(curve.evaluate(t).y, expected.y);
+        const Point2D<double> cubic = evaluateBezierCubic(control[0], control[1], control[2], control[3], t);
+        QVERIFY(std::abs(cubic.x - expected.x) < 1e-14 && std::abs(cubic.y - expected.y) < 1e-14);
+    }
+
+    bool thrown = false;
+    try {
+        curve.evaluate(1.5);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    QVERIFY(thrown);
+}
+
+void PlaneGeometryTests::uniform_sampler_matches_sample_bezier() {
+    const std::vector<Point2D<double>> control{{0.0, 0.0}, {0.3, 1.7}, {1.1, -0.4}, {2.0, 1.0}, {2.5, 0.2}};
+    std::vector<Point2D<double>> samples;
+    for (const std::size_t count : {2u, 3u, 33u, 1000u}) {
+        const auto expected = sampleBezier(control, count);
+        sampleBezierUniform(control, count, samples);
+        QCOMPARE(samples.size(), expected.size());
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            QVERIFY(std::abs(samples[i].x - expected[i].x) < 1e-12);
+            QVERIFY(std::abs(samples[i].y - expected[i].y) < 1e-12);
+        }
+        QCOMPARE(samples.front().x, control.front().x);
+        QCOMPARE(samples.back().x, control.back().x);
+        QCOMPARE(samples.back().y, control.back().y);
+    }
+}
+
+void PlaneGeometryTests::flatten_stays_within_tolerance() {
+    const std::vector<Point2D<double>> control{{0.0, 0.0}, {0.0, 100.0}, {100.0, 100.0}, {100.0, 0.0}};
+    for (const double tolerance : {1.0, 0.25, 0.01}) {
+        const auto polyline = flattenBezier(control, tolerance);
+        QCOMPARE(polyline.front().x, control.front().x);
+        QCOMPARE(polyline.back().x, control.back().x);
+        QCOMPARE(polyline.back().y, control.back().y);
+        // Every point of the curve lies within tolerance of the polyline.
+        for (int i = 0; i <= 2000; ++i) {
+            const Point2D<double> point = evaluateBezier(control, i / 2000.0);
+            double distance = std::numeric_limits<double>::max();
+            for (std::size_t j = 0; j + 1 < polyline.size(); ++j) {
+                distance = std::min(distance, distanceToSegment(point, polyline[j], polyline[j + 1]));
+            }
+            QVERIFY(distance <= tolerance);
+        }
+    }
+
+    // A straight curve needs no vertices in between.
+    const std::vector<Point2D<double>> straight{{0.0, 0.0}, {1.0, 1.0}, {2.0, 2.0}, {3.0, 3.0}};
+    QCOMPARE(static_cast<int>(flattenBezier(straight, 1e-6).size()), 2);
+}
+
+void PlaneGeometryTests::batch_cubic_matches_scalar() {
+    std::mt19937 generator(41);
+    std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+    CubicBezierBatch<double> curves;
+    std::vector<std::array<Point2D<double>, 4>> controls;
+    // Seven curves leave tails for both vector widths.
+    for (int i = 0; i < 7; ++i) {
+        std::array<Point2D<double>, 4> control;
+        for (auto& point : control) {
+            point = {coordinate(generator), coordinate(generator)};
+        }
+        controls.push_back(control);
+        curves.push_back(control[0], control[1], control[2], control[3]);
+    }
+    std::vector<double> parameters;
+    for (int j = 0; j <= 50; ++j) {
+        parameters.push_back(j / 50.0);
+    }
+    std::vector<Point2D<double>> result;
+    evaluateBezierCubicBatch(curves, parameters, result);
+    QCOMPARE(result.size(), parameters.size() * controls.size());
+    for (std::size_t j = 0; j < parameters.size(); ++j) {
+        for (std::size_t i = 0; i < controls.size(); ++i) {
+            const auto& c = controls[i];
+            const Point2D<double> expected = evaluateBezierCubic(c[0], c[1], c[2], c[3], parameters[j]);
+            QCOMPARE(result[j * controls.size() + i].x, expected.x);
+            QCOMPARE(result[j * controls.size() + i].y, expected.y);
+        }
+    }
+}
+
+void PlaneGeometryTests::bezier_known_intersections() {
+    // The arch x = 2t, y = 4t(1 - t) meets y = 0.5 where t(1 - t) = 1/8.
+    const std::vector<Point2D<double>> arch{{0.0, 0.0}, {1.0, 2.0}, {2.0, 0.0}};
+    const double low = (1.0 - std::sqrt(0.5)) / 2.0;
+    const double high = (1.0 + std::sqrt(0.5)) / 2.0;
+
+    const auto segmentHits = intersectBezierSegment(arch, Segment2D<double>{{0.0, 0.5}, {2.0, 0.5}});
+    QCOMPARE(static_cast<int>(segmentHits.size()), 2);
+    QVERIFY(std::abs(segmentHits[0].firstParameter - low) < 1e-8);
+    QVERIFY(std::abs(segmentHits[1].firstParameter - high) < 1e-8);
+    QVERIFY(std::abs(segmentHits[0].secondParameter - low) < 1e-8);
+    QVERIFY(std::abs(segmentHits[0].point.y - 0.5) < 1e-8);
+
+    // Mirrored about y = 0.5 it crosses the arch at the same parameters.
+    const std::vector<Point2D<double>> mirrored{{0.0, 1.0}, {1.0, -1.0}, {2.0, 1.0}};
+    const auto curveHits = intersectBezierCurves(arch, mirrored);
+    QCOMPARE(static_cast<int>(curveHits.size()), 2);
+    QVERIFY(std::abs(curveHits[0].firstParameter - low) < 1e-8);
+    QVERIFY(std::abs(curveHits[0].secondParameter - low) < 1e-8);
+    QVERIFY(std::abs(curveHits[1].firstParameter - high) < 1e-8);
+
+    // Touching the top of the arch is one tangent hit; above it there is none.
+    QCOMPARE(static_cast<int>(intersectBezierSegment(arch, Segment2D<double>{{0.0, 1.0}, {2.0, 1.0}}).size()), 1);
+    QVERIFY(intersectBezierSegment(arch, Segment2D<double>{{0.0, 1.5}, {2.0, 1.5}}).empty());
+}
+
+QTEST_APPLESS_MAIN(PlaneGeometryTests)
+#include "PlaneGeometryTests.moc"